@@ -0,0 +1,215 @@
+#include "AllocAudit.h"
+#include <atomic>
+
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#define ALLOC_AUDIT_CRT_HOOK
+#elif defined(__GLIBC__)
+#define ALLOC_AUDIT_MALLOC_HOOK
+#endif
+
+struct AllocAuditHandler
+{
+    const char* name;
+    std::atomic<uint32_t> calls;
+    std::atomic<uint64_t> allocations;
+};
+
+thread_local uint64_t t_allocations = 0;
+thread_local uint32_t t_scopeDepth = 0;
+
+std::mutex g_allocAuditMutex;
+AllocAuditHandler g_allocAuditHandlers[ALLOC_AUDIT_MAX_HANDLERS] = {};
+std::atomic<uint64_t> g_allocAuditViolations{ 0 };
+std::atomic<AllocAuditReportFunc> g_allocAuditReport{ nullptr };
+
+/////////////////////
+// Counting
+/////////////////////
+
+#ifdef ALLOC_AUDIT_CRT_HOOK
+
+static int AllocAuditCrtHook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+    (void)userData; (void)size; (void)requestNumber; (void)fileName; (void)lineNumber;
+
+    if ((allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) && blockType != _CRT_BLOCK)
+    {
+        ++t_allocations;
+    }
+    return TRUE;
+}
+
+#elif defined(ALLOC_AUDIT_MALLOC_HOOK)
+
+// glibc's allocator stays underneath, operator new reaches it through malloc
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* memory, size_t size);
+
+    void* malloc(size_t size)
+    {
+        ++t_allocations;
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        ++t_allocations;
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* memory, size_t size)
+    {
+        ++t_allocations;
+        return __libc_realloc(memory, size);
+    }
+}
+
+#else
+
+void* operator new(std::size_t size)
+{
+    ++t_allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++t_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#endif
+
+/////////////////////
+// Attribution
+/////////////////////
+
+static AllocAuditHandler* FindHandler(const char* handlerName)
+{
+    // Handler names are __FUNCTION__ literals, so pointers are compared
+    std::lock_guard<std::mutex> lock(g_allocAuditMutex);
+    for (AllocAuditHandler& handler : g_allocAuditHandlers)
+    {
+        if (handler.name == handlerName)
+        {
+            return &handler;
+        }
+        if (!handler.name)
+        {
+            handler.name = handlerName;
+            return &handler;
+        }
+    }
+
+    return nullptr;
+}
+
+AllocAuditScope::AllocAuditScope(const char* handlerName)
+    : m_handlerName(handlerName)
+    , m_allocationsAtStart(t_allocations)
+    , m_isOutermost(t_scopeDepth++ == 0)
+{
+}
+
+AllocAuditScope::~AllocAuditScope()
+{
+    --t_scopeDepth;
+    if (!m_isOutermost)
+    {
+        return;
+    }
+
+    uint64_t allocations = t_allocations - m_allocationsAtStart;
+
+    AllocAuditHandler* handler = FindHandler(m_handlerName);
+    if (!handler)
+    {
+        return;
+    }
+
+    uint32_t calls = handler->calls.fetch_add(1, std::memory_order_relaxed) + 1;
+    handler->allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+    if (allocations > 0 && calls > ALLOC_AUDIT_WARMUP_CALLS)
+    {
+        g_allocAuditViolations.fetch_add(1, std::memory_order_relaxed);
+
+        AllocAuditReportFunc report = g_allocAuditReport.load(std::memory_order_acquire);
+        if (report)
+        {
+            report(m_handlerName, allocations);
+        }
+    }
+}
+
+void InstallAllocAudit(AllocAuditReportFunc report)
+{
+    g_allocAuditReport.store(report, std::memory_order_release);
+
+#ifdef ALLOC_AUDIT_CRT_HOOK
+    _CrtSetAllocHook(AllocAuditCrtHook);
+#endif
+}
+
+uint64_t GetAllocAuditViolations()
+{
+    return g_allocAuditViolations.load(std::memory_order_relaxed);
+}
+
+#else
+
+void InstallAllocAudit(AllocAuditReportFunc report)
+{
+    (void)report;
+}
+
+uint64_t GetAllocAuditViolations()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// The Allocation Audit counts heap allocations per thread and attributes them to the exported handler that is running.
+// Getters and setters must be allocation-free in steady state: after a short warm-up, every allocation made inside
+// a handler is reported as a violation. Only compiled in with DE_BRIDGE_ALLOC_AUDIT (the Audit configuration),
+// otherwise ALLOC_AUDIT_SCOPE() expands to nothing.
+//
+// Allocations are counted through the CRT allocation hook in MSVC debug builds and through replaced malloc, calloc
+// and realloc with glibc, both cover operator new too. Elsewhere only a replaced global operator new counts them.
+
+constexpr uint32_t ALLOC_AUDIT_WARMUP_CALLS = 2;
+constexpr uint32_t ALLOC_AUDIT_MAX_HANDLERS = 32;
+
+typedef void (*AllocAuditReportFunc)(const char* handlerName, uint64_t allocations);
+
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+
+class AllocAuditScope
+{
+public:
+    explicit AllocAuditScope(const char* handlerName);
+    ~AllocAuditScope();
+
+    AllocAuditScope(const AllocAuditScope&) = delete;
+    AllocAuditScope& operator=(const AllocAuditScope&) = delete;
+
+private:
+    const char* m_handlerName;
+    uint64_t m_allocationsAtStart;
+    bool m_isOutermost;
+};
+
+#define ALLOC_AUDIT_SCOPE() AllocAuditScope allocAuditScope(__FUNCTION__)
+
+#else
+
+#define ALLOC_AUDIT_SCOPE() do {} while(0)
+
+#endif
+
+// Report is called on the handler's thread for every violation
+void InstallAllocAudit(AllocAuditReportFunc report);
+uint64_t GetAllocAuditViolations();
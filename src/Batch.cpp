@@ -0,0 +1,97 @@
+#include "Batch.h"
+#include "ModeCache.h"
+
+uint32_t RunBatch(const int32_t* ops, uint32_t count, int32_t* results)
+{
+    uint32_t failed = 0;
+    int32_t mode = MODE_UNKNOWN;
+    bool isModeRead = false;
+
+    if (count > BATCH_MAX_OPS)
+    {
+        count = BATCH_MAX_OPS;
+    }
+
+    // An operation with bits set above its argument isn't cut down to one that looks valid, the batch isn't run at all
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (ops[i] < 0 || (ops[i] >> 16) != 0)
+        {
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                results[j] = BATCH_RESULT_BAD_ARGUMENT;
+            }
+            return count;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        BatchOp op = static_cast<BatchOp>(ops[i] & 0xff);
+        int32_t argument = (ops[i] >> 8) & 0xff;
+
+        // Gets and toggles need the mode, it's read once and then followed through the sets
+        if ((op == BatchOp::Get || op == BatchOp::Toggle) && !isModeRead)
+        {
+            DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+            if (QueryFrameGenerationMode(currentMode) == DLSS_ENABLER_RESULT_SUCCESS)
+            {
+                mode = currentMode;
+            }
+            isModeRead = true;
+        }
+
+        bool hasSetMode = true;
+        DLSS_ENABLER_FRAMEGENERATION_MODE setMode = DLSS_ENABLER_FRAMEGENERATION_DISABLED;
+        int32_t result = BATCH_RESULT_BAD_ARGUMENT;
+
+        switch (op)
+        {
+        case BatchOp::Get:
+            hasSetMode = false;
+            result = mode >= 0 ? mode : BATCH_RESULT_FAILED;
+            break;
+        case BatchOp::SetMode:
+            hasSetMode = argument <= 3;
+            setMode = static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(argument);
+            break;
+        case BatchOp::SetFG:
+            hasSetMode = argument <= 1;
+            setMode = argument ? DLSS_ENABLER_FRAMEGENERATION_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DISABLED;
+            break;
+        case BatchOp::SetDFG:
+            hasSetMode = argument <= 1;
+            setMode = argument ? DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED;
+            break;
+        case BatchOp::Toggle:
+            hasSetMode = mode == DLSS_ENABLER_FRAMEGENERATION_DISABLED || mode == DLSS_ENABLER_FRAMEGENERATION_ENABLED;
+            setMode = mode == DLSS_ENABLER_FRAMEGENERATION_DISABLED ? DLSS_ENABLER_FRAMEGENERATION_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DISABLED;
+            result = BATCH_RESULT_FAILED;
+            break;
+        default:
+            hasSetMode = false;
+            break;
+        }
+
+        if (hasSetMode)
+        {
+            if (ApplyFrameGenerationMode(setMode) == DLSS_ENABLER_RESULT_SUCCESS)
+            {
+                mode = PredictSetMode(mode, setMode);
+                result = BATCH_RESULT_SUCCESS;
+            }
+            else
+            {
+                result = BATCH_RESULT_FAILED;
+            }
+        }
+
+        if (result < 0)
+        {
+            ++failed;
+        }
+        results[i] = result;
+    }
+
+    return failed;
+}
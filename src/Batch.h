@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// A Batch runs several operations in order, so a script pays for one call instead of one per operation.
+// The caller checks readiness once, the mode is read from DLSS Enabler at most once and then followed through the sets.
+// Each operation is encoded as its code in the low byte and its argument in the next one, see EncodeBatchOp.
+
+enum class BatchOp : uint8_t
+{
+    Get = 0,        // result: the mode (0-3)
+    SetMode = 1,    // argument: the mode (0-3)
+    SetFG = 2,      // argument: 0 or 1
+    SetDFG = 3,     // argument: 0 or 1
+    Toggle = 4,     // toggles Frame Generation, as DLSSEnabler_ToggleFrameGenerationState
+};
+
+constexpr uint32_t BATCH_MAX_OPS = 32;
+
+// Set and toggle operations answer BATCH_RESULT_SUCCESS, all failures are negative
+constexpr int32_t BATCH_RESULT_SUCCESS = 1;
+constexpr int32_t BATCH_RESULT_BAD_ARGUMENT = -1;
+constexpr int32_t BATCH_RESULT_FAILED = -2;
+constexpr int32_t BATCH_RESULT_NOT_READY = -3;
+
+constexpr int32_t EncodeBatchOp(BatchOp op, int32_t argument = 0)
+{
+    return static_cast<int32_t>(op) | (argument << 8);
+}
+
+// Runs up to BATCH_MAX_OPS operations, writing one result each. Returns the number of failed operations.
+// If any operation is malformed (negative, or bits set above the argument byte), none is run and all answer BATCH_RESULT_BAD_ARGUMENT.
+uint32_t RunBatch(const int32_t* ops, uint32_t count, int32_t* results);
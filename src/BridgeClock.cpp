@@ -0,0 +1,21 @@
+#include "BridgeClock.h"
+#include <atomic>
+#include <chrono>
+
+std::atomic<BridgeClockSource> g_bridgeClockSource{ nullptr };
+
+int64_t GetBridgeClockMs()
+{
+    BridgeClockSource source = g_bridgeClockSource.load(std::memory_order_acquire);
+    if (source)
+    {
+        return source();
+    }
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SetBridgeClockSource(BridgeClockSource source)
+{
+    g_bridgeClockSource.store(source, std::memory_order_release);
+}
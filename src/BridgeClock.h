@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// The Bridge Clock is the time base of the bridge's own timing (e.g. the cache TTL), in milliseconds.
+// It follows steady_clock, unless a source is set: the simulator drives the bridge with a synthetic clock.
+
+typedef int64_t (*BridgeClockSource)();
+
+int64_t GetBridgeClockMs();
+
+// Pass nullptr to go back to steady_clock
+void SetBridgeClockSource(BridgeClockSource source);
@@ -0,0 +1,125 @@
+#include "CommandQueue.h"
+#include "Config.h"
+#include "ModeCache.h"
+#include <atomic>
+#include <mutex>
+
+const ModePreset g_presets[] =
+{
+    { "off", 1, { DLSS_ENABLER_FRAMEGENERATION_DISABLED } },
+    { "fg", 2, { DLSS_ENABLER_FRAMEGENERATION_ENABLED, DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED } },
+    { "dfg", 2, { DLSS_ENABLER_FRAMEGENERATION_ENABLED, DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED } },
+};
+
+std::mutex g_commandQueueMutex;
+DLSS_ENABLER_FRAMEGENERATION_MODE g_commandQueue[COMMAND_QUEUE_CAPACITY];
+uint32_t g_commandQueueHead = 0;
+std::atomic<uint32_t> g_commandQueueCount{ 0 };
+
+/////////////////////
+// Presets
+/////////////////////
+
+const ModePreset* FindPreset(std::string_view name)
+{
+    for (const ModePreset& preset : g_presets)
+    {
+        if (name == preset.name)
+        {
+            return &preset;
+        }
+    }
+
+    return nullptr;
+}
+
+/////////////////////
+// Queue
+/////////////////////
+
+static void CoalesceLocked()
+{
+    if (GetConfig().queueMode == QueueMode::Coalesce)
+    {
+        g_commandQueueHead = 0;
+        g_commandQueueCount.store(0, std::memory_order_release);
+    }
+}
+
+static void PushLocked(DLSS_ENABLER_FRAMEGENERATION_MODE mode)
+{
+    uint32_t count = g_commandQueueCount.load(std::memory_order_relaxed);
+    g_commandQueue[(g_commandQueueHead + count) % COMMAND_QUEUE_CAPACITY] = mode;
+    g_commandQueueCount.store(count + 1, std::memory_order_release);
+}
+
+bool QueueFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE mode)
+{
+    std::lock_guard<std::mutex> lock(g_commandQueueMutex);
+    CoalesceLocked();
+    if (g_commandQueueCount.load(std::memory_order_relaxed) >= COMMAND_QUEUE_CAPACITY)
+    {
+        return false;
+    }
+
+    PushLocked(mode);
+    return true;
+}
+
+bool QueuePreset(const ModePreset& preset)
+{
+    std::lock_guard<std::mutex> lock(g_commandQueueMutex);
+    CoalesceLocked();
+    if (g_commandQueueCount.load(std::memory_order_relaxed) + preset.count > COMMAND_QUEUE_CAPACITY)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < preset.count; ++i)
+    {
+        PushLocked(preset.modes[i]);
+    }
+    return true;
+}
+
+uint32_t GetQueuedCommandCount()
+{
+    return g_commandQueueCount.load(std::memory_order_acquire);
+}
+
+void ClearCommandQueue()
+{
+    std::lock_guard<std::mutex> lock(g_commandQueueMutex);
+    g_commandQueueHead = 0;
+    g_commandQueueCount.store(0, std::memory_order_release);
+}
+
+uint32_t DrainCommandQueue()
+{
+    uint32_t failed = 0;
+
+    for (;;)
+    {
+        DLSS_ENABLER_FRAMEGENERATION_MODE mode;
+        {
+            std::lock_guard<std::mutex> lock(g_commandQueueMutex);
+            uint32_t count = g_commandQueueCount.load(std::memory_order_relaxed);
+            if (count == 0)
+            {
+                break;
+            }
+
+            mode = g_commandQueue[g_commandQueueHead];
+            g_commandQueueHead = (g_commandQueueHead + 1) % COMMAND_QUEUE_CAPACITY;
+            g_commandQueueCount.store(count - 1, std::memory_order_release);
+        }
+
+        // Applied outside of the lock, so the Control Channel is never blocked by DLSS Enabler
+        if (ApplyFrameGenerationMode(mode) != DLSS_ENABLER_RESULT_SUCCESS)
+        {
+            ++failed;
+        }
+    }
+
+    return failed;
+}
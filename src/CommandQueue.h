@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "DLSSEnablerApi.h"
+
+// The Command Queue holds mode changes requested off the game thread (e.g. by the Control Channel).
+// They're applied in order by DrainCommandQueue at the next safe point on the game thread.
+
+constexpr uint32_t COMMAND_QUEUE_CAPACITY = 32;
+constexpr uint32_t MAX_PRESET_MODES = 2;
+
+// A preset is a short sequence of set modes reaching one Frame Generation state
+struct ModePreset
+{
+    const char* name;
+    uint32_t count;
+    DLSS_ENABLER_FRAMEGENERATION_MODE modes[MAX_PRESET_MODES];
+};
+
+const ModePreset* FindPreset(std::string_view name);
+
+// Returns false if the queue is full, presets are queued all or nothing.
+// In the Coalesce queue mode, everything still queued is dropped first.
+bool QueueFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE mode);
+bool QueuePreset(const ModePreset& preset);
+
+uint32_t GetQueuedCommandCount();
+void ClearCommandQueue();
+
+// Game thread only. Returns the number of commands that failed.
+uint32_t DrainCommandQueue();
@@ -0,0 +1,399 @@
+#include "Config.h"
+#include "CommandQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const BridgeConfig g_defaultConfig;
+std::atomic<const BridgeConfig*> g_currentConfig{ &g_defaultConfig };
+std::atomic<uint64_t> g_configGeneration{ 0 };
+
+// Snapshots are written round-robin: the current and the previous one are never overwritten, so a reader's
+// snapshot stays intact until the second publish after it
+std::mutex g_configSnapshotsMutex;
+BridgeConfig g_configSnapshots[CONFIG_SNAPSHOT_SLOTS];
+uint32_t g_nextConfigSnapshot = 0;
+
+std::atomic<uint32_t> g_configErrorCount{ 0 };
+std::atomic<uint32_t> g_configFirstErrorLine{ 0 };
+
+std::thread g_configWatcherThread;
+std::mutex g_configWatcherMutex;
+std::condition_variable g_configWatcherCondition;
+bool g_isConfigWatcherStopping = false;
+
+////////////////////////
+// Parser: works on views of the file buffer, nothing is copied or allocated
+////////////////////////
+
+static std::string_view TrimConfig(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r'))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+static bool ParseUInt(std::string_view value, uint32_t& out)
+{
+    uint32_t parsed = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (error != std::errc() || end != value.data() + value.size())
+    {
+        return false;
+    }
+
+    out = parsed;
+    return true;
+}
+
+static bool ParseBool(std::string_view value, bool& out)
+{
+    if (value == "true" || value == "1")
+    {
+        out = true;
+        return true;
+    }
+    if (value == "false" || value == "0")
+    {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+static bool ParseConfigValue(std::string_view key, std::string_view value, BridgeConfig& config)
+{
+    if (key == "cache_ttl_ms")
+    {
+        return ParseUInt(value, config.cacheTtlMs);
+    }
+    if (key == "watcher_poll_ms")
+    {
+        uint32_t pollMs;
+        if (!ParseUInt(value, pollMs) || pollMs < 100)
+        {
+            return false;
+        }
+        config.watcherPollMs = pollMs;
+        return true;
+    }
+    if (key == "log_level")
+    {
+        if (value == "error") config.logLevel = LogLevel::Error;
+        else if (value == "debug") config.logLevel = LogLevel::Debug;
+        else if (value == "debug-ext") config.logLevel = LogLevel::DebugExt;
+        else return false;
+        return true;
+    }
+    if (key == "queue_mode")
+    {
+        if (value == "fifo") config.queueMode = QueueMode::Fifo;
+        else if (value == "coalesce") config.queueMode = QueueMode::Coalesce;
+        else return false;
+        return true;
+    }
+    if (key == "probe_timeout_ms")
+    {
+        return ParseUInt(value, config.probeTimeoutMs);
+    }
+    if (key == "probe_hold_ms")
+    {
+        return ParseUInt(value, config.probeHoldMs);
+    }
+    if (key == "control_channel")
+    {
+        return ParseBool(value, config.isControlChannelEnabled);
+    }
+    if (key == "transition_probe")
+    {
+        return ParseBool(value, config.isTransitionProbeEnabled);
+    }
+    if (key == "profiles")
+    {
+        return ParseBool(value, config.isProfileStoreEnabled);
+    }
+    if (key == "default_preset")
+    {
+        if (value.size() >= CONFIG_MAX_PRESET_NAME || (!value.empty() && !FindPreset(value)))
+        {
+            return false;
+        }
+        memcpy(config.defaultPreset, value.data(), value.size());
+        config.defaultPreset[value.size()] = '\0';
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t ParseConfig(std::string_view text, BridgeConfig& config, uint32_t& firstErrorLine)
+{
+    uint32_t errorCount = 0;
+    uint32_t lineNumber = 0;
+    firstErrorLine = 0;
+
+    while (!text.empty())
+    {
+        size_t lineEnd = text.find('\n');
+        std::string_view line = text.substr(0, lineEnd);
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+        ++lineNumber;
+
+        size_t comment = line.find_first_of("#;");
+        line = TrimConfig(line.substr(0, comment));
+
+        // Empty lines and [sections] carry no settings
+        if (line.empty() || line.front() == '[')
+        {
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        bool isValid = separator != std::string_view::npos;
+        if (isValid)
+        {
+            isValid = ParseConfigValue(TrimConfig(line.substr(0, separator)), TrimConfig(line.substr(separator + 1)), config);
+        }
+
+        if (!isValid)
+        {
+            if (errorCount++ == 0)
+            {
+                firstErrorLine = lineNumber;
+            }
+        }
+    }
+
+    return errorCount;
+}
+
+/////////////////////
+// Snapshots
+/////////////////////
+
+const BridgeConfig& GetConfig()
+{
+    return *g_currentConfig.load(std::memory_order_acquire);
+}
+
+uint64_t GetConfigGeneration()
+{
+    return g_configGeneration.load(std::memory_order_acquire);
+}
+
+void PublishConfig(const BridgeConfig& config)
+{
+    std::lock_guard<std::mutex> lock(g_configSnapshotsMutex);
+    BridgeConfig& snapshot = g_configSnapshots[g_nextConfigSnapshot];
+    g_nextConfigSnapshot = (g_nextConfigSnapshot + 1) % CONFIG_SNAPSHOT_SLOTS;
+    snapshot = config;
+    g_currentConfig.store(&snapshot, std::memory_order_release);
+    g_configGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void ResetConfig()
+{
+    std::lock_guard<std::mutex> lock(g_configSnapshotsMutex);
+    g_currentConfig.store(&g_defaultConfig, std::memory_order_release);
+    g_nextConfigSnapshot = 0;
+    g_configErrorCount.store(0, std::memory_order_relaxed);
+    g_configFirstErrorLine.store(0, std::memory_order_relaxed);
+}
+
+/////////////////////
+// File
+/////////////////////
+
+// Reads up to size bytes without allocating, false if the file can't be opened or read
+static bool ReadConfigFile(const std::filesystem::path& path, char* buffer, size_t size, size_t& bytesRead)
+{
+    bytesRead = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    bool isRead = true;
+    while (bytesRead < size)
+    {
+        DWORD chunk = 0;
+        if (!ReadFile(file, buffer + bytesRead, static_cast<DWORD>(size - bytesRead), &chunk, nullptr))
+        {
+            isRead = false;
+            break;
+        }
+        if (chunk == 0)
+        {
+            break;
+        }
+        bytesRead += chunk;
+    }
+
+    CloseHandle(file);
+    return isRead;
+#else
+    int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    bool isRead = true;
+    while (bytesRead < size)
+    {
+        ssize_t chunk = read(file, buffer + bytesRead, size - bytesRead);
+        if (chunk < 0)
+        {
+            isRead = false;
+            break;
+        }
+        if (chunk == 0)
+        {
+            break;
+        }
+        bytesRead += static_cast<size_t>(chunk);
+    }
+
+    close(file);
+    return isRead;
+#endif
+}
+
+bool LoadConfigFile(const std::filesystem::path& path, uint32_t& errorCount, uint32_t& firstErrorLine)
+{
+    // One byte more than is parsed tells whether the file is longer
+    static char buffer[CONFIG_MAX_FILE_SIZE + 1];
+
+    BridgeConfig config;
+    errorCount = 0;
+    firstErrorLine = 0;
+
+    size_t bytesRead;
+    if (!ReadConfigFile(path, buffer, sizeof(buffer), bytesRead))
+    {
+        g_configErrorCount.store(0, std::memory_order_relaxed);
+        g_configFirstErrorLine.store(0, std::memory_order_relaxed);
+        PublishConfig(config);
+        return false;
+    }
+
+    // A longer file is cut after its last complete line, so no value is cut short. The rest counts as one invalid line.
+    bool isTruncated = bytesRead > CONFIG_MAX_FILE_SIZE;
+    std::string_view text(buffer, isTruncated ? CONFIG_MAX_FILE_SIZE : bytesRead);
+    if (isTruncated)
+    {
+        size_t lastLineEnd = text.rfind('\n');
+        text = text.substr(0, lastLineEnd == std::string_view::npos ? 0 : lastLineEnd + 1);
+    }
+
+    errorCount = ParseConfig(text, config, firstErrorLine);
+    if (isTruncated && errorCount++ == 0)
+    {
+        firstErrorLine = static_cast<uint32_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+    }
+
+    g_configErrorCount.store(errorCount, std::memory_order_relaxed);
+    g_configFirstErrorLine.store(firstErrorLine, std::memory_order_relaxed);
+    PublishConfig(config);
+    return true;
+}
+
+uint32_t GetConfigErrorCount()
+{
+    return g_configErrorCount.load(std::memory_order_relaxed);
+}
+
+uint32_t GetConfigFirstErrorLine()
+{
+    return g_configFirstErrorLine.load(std::memory_order_relaxed);
+}
+
+/////////////////////
+// Watcher
+/////////////////////
+
+static std::filesystem::file_time_type GetConfigWriteTime(const std::filesystem::path& path)
+{
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : writeTime;
+}
+
+static void ConfigWatcherThread(std::filesystem::path path)
+{
+    std::filesystem::file_time_type lastWriteTime = GetConfigWriteTime(path);
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(g_configWatcherMutex);
+            g_configWatcherCondition.wait_for(lock, std::chrono::milliseconds(GetConfig().watcherPollMs), [] { return g_isConfigWatcherStopping; });
+            if (g_isConfigWatcherStopping)
+            {
+                return;
+            }
+        }
+
+        std::filesystem::file_time_type writeTime = GetConfigWriteTime(path);
+        if (writeTime != lastWriteTime)
+        {
+            lastWriteTime = writeTime;
+
+            uint32_t errorCount;
+            uint32_t firstErrorLine;
+            LoadConfigFile(path, errorCount, firstErrorLine);
+        }
+    }
+}
+
+bool StartConfigWatcher(const std::filesystem::path& path)
+{
+    if (g_configWatcherThread.joinable())
+    {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_configWatcherMutex);
+        g_isConfigWatcherStopping = false;
+    }
+
+    g_configWatcherThread = std::thread(ConfigWatcherThread, path);
+    return true;
+}
+
+void StopConfigWatcher()
+{
+    if (!g_configWatcherThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_configWatcherMutex);
+        g_isConfigWatcherStopping = true;
+    }
+    g_configWatcherCondition.notify_one();
+    g_configWatcherThread.join();
+}
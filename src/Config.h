@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include "TransitionProbe.h"
+
+// The Config is read from dlss-enabler-bridge-2077.ini next to the plugin and reloaded when the file changes.
+// Every load publishes a new immutable snapshot, readers always see one consistent config without locking.
+// See docs/configuration.md for the keys.
+
+#define CONFIG_FILE_NAME L"dlss-enabler-bridge-2077.ini"
+
+constexpr size_t CONFIG_MAX_FILE_SIZE = 4096;
+constexpr size_t CONFIG_MAX_PRESET_NAME = 16;
+constexpr uint32_t CONFIG_SNAPSHOT_SLOTS = 3;
+
+enum class LogLevel : uint8_t
+{
+    Error = 0,
+    Debug = 1,
+    DebugExt = 2,
+};
+
+enum class QueueMode : uint8_t
+{
+    Fifo = 0,       // queued mode changes are applied in order
+    Coalesce = 1,   // a new request replaces everything still queued
+};
+
+struct BridgeConfig
+{
+    uint32_t cacheTtlMs = 0;        // 0: every getter asks DLSS Enabler
+    uint32_t watcherPollMs = 1000;
+    LogLevel logLevel = LogLevel::Error;
+    QueueMode queueMode = QueueMode::Fifo;
+    uint32_t probeTimeoutMs = TRANSITION_PROBE_TIMEOUT_MS;
+    uint32_t probeHoldMs = TRANSITION_PROBE_HOLD_MS;
+    bool isControlChannelEnabled = false;
+    bool isTransitionProbeEnabled = false;
+    bool isProfileStoreEnabled = true;
+    char defaultPreset[CONFIG_MAX_PRESET_NAME] = "";
+};
+
+// Parses in place without allocating. Invalid lines are skipped, returns the number of them and the first one's number.
+uint32_t ParseConfig(std::string_view text, BridgeConfig& config, uint32_t& firstErrorLine);
+
+// Current snapshot, valid until the second publish after it or ResetConfig. Read what's needed, don't keep it.
+const BridgeConfig& GetConfig();
+uint64_t GetConfigGeneration();
+void PublishConfig(const BridgeConfig& config);
+void ResetConfig();
+
+// Loads the file and publishes it. Returns false if the file can't be read (defaults are published then).
+bool LoadConfigFile(const std::filesystem::path& path, uint32_t& errorCount, uint32_t& firstErrorLine);
+
+// Polls the file's modification time and reloads it when changed
+bool StartConfigWatcher(const std::filesystem::path& path);
+void StopConfigWatcher();
+
+// Results of the last load, for logging on the game thread
+uint32_t GetConfigErrorCount();
+uint32_t GetConfigFirstErrorLine();
@@ -0,0 +1,455 @@
+#include "ControlChannel.h"
+#include "CommandQueue.h"
+#include "ModeCache.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+std::thread g_controlChannelThread;
+std::atomic<bool> g_isControlChannelRunning{ false };   // cleared by the server thread when it exits, also on its own
+
+#ifdef _WIN32
+HANDLE g_controlChannelPipe = INVALID_HANDLE_VALUE;
+HANDLE g_controlChannelStopEvent = nullptr;
+#else
+int g_controlChannelSocket = -1;
+std::atomic<int> g_controlChannelClient{ -1 };
+std::atomic<bool> g_isControlChannelStopping{ false };
+#endif
+
+struct ControlLineBuffer
+{
+    char data[CONTROL_CHANNEL_LINE_SIZE];
+    size_t size;
+    bool isOverflowing;
+};
+
+////////////////////////
+// Commands: parsed in place, nothing here allocates
+////////////////////////
+
+static std::string_view Trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r'))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// snprintf returns the untruncated length, the reply is cut at replySize - 1
+static size_t ReplyLength(int length, size_t replySize)
+{
+    if (length <= 0)
+    {
+        return 0;
+    }
+
+    return static_cast<size_t>(length) < replySize ? static_cast<size_t>(length) : replySize - 1;
+}
+
+static size_t WriteReply(char* reply, size_t replySize, const char* text)
+{
+    return ReplyLength(snprintf(reply, replySize, "%s\n", text), replySize);
+}
+
+size_t HandleControlCommand(std::string_view line, char* reply, size_t replySize)
+{
+    line = Trim(line);
+
+    std::string_view command = line;
+    std::string_view argument;
+    size_t separator = line.find(' ');
+    if (separator != std::string_view::npos)
+    {
+        command = line.substr(0, separator);
+        argument = Trim(line.substr(separator + 1));
+    }
+
+    if (command == "GET")
+    {
+        // Like the script getter, DLSS Enabler isn't called unless the game thread last saw the game ready
+        if (GetReadyState() != ReadyState::Ready)
+        {
+            return WriteReply(reply, replySize, "ERR not-ready");
+        }
+
+        DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+        DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
+        if (result != DLSS_ENABLER_RESULT_SUCCESS)
+        {
+            return ReplyLength(snprintf(reply, replySize, "ERR result=%d\n", result), replySize);
+        }
+
+        return ReplyLength(snprintf(reply, replySize, "OK %d\n", currentMode), replySize);
+    }
+
+    if (command == "SET")
+    {
+        if (argument.size() != 1 || argument[0] < '0' || argument[0] > '3')
+        {
+            return WriteReply(reply, replySize, "ERR bad-argument");
+        }
+
+        DLSS_ENABLER_FRAMEGENERATION_MODE newMode = static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(argument[0] - '0');
+        return WriteReply(reply, replySize, QueueFrameGenerationMode(newMode) ? "QUEUED" : "ERR queue-full");
+    }
+
+    if (command == "PRESET")
+    {
+        const ModePreset* preset = FindPreset(argument);
+        if (!preset)
+        {
+            return WriteReply(reply, replySize, "ERR unknown-preset");
+        }
+
+        return WriteReply(reply, replySize, QueuePreset(*preset) ? "QUEUED" : "ERR queue-full");
+    }
+
+    if (command == "STATS")
+    {
+        ModeSnapshot snapshot = GetModeSnapshot();
+        int length = snprintf(reply, replySize,
+            "OK mode=%d ready=%d loaded=%d changes=%llu get=%llu get_failed=%llu set=%llu set_failed=%llu queued=%u\n",
+            snapshot.mode,
+            static_cast<int>(snapshot.readyState),
+            snapshot.isLoaded ? 1 : 0,
+            static_cast<unsigned long long>(snapshot.changeCounter),
+            static_cast<unsigned long long>(snapshot.getCalls),
+            static_cast<unsigned long long>(snapshot.getFailures),
+            static_cast<unsigned long long>(snapshot.setCalls),
+            static_cast<unsigned long long>(snapshot.setFailures),
+            GetQueuedCommandCount());
+        return ReplyLength(length, replySize);
+    }
+
+    return WriteReply(reply, replySize, "ERR unknown-command");
+}
+
+// Splits received bytes into lines and replies to each. Returns false if the reply couldn't be sent.
+template <typename WriteFunc>
+static bool ProcessControlBytes(ControlLineBuffer& buffer, const char* data, size_t size, WriteFunc&& write)
+{
+    char reply[CONTROL_CHANNEL_LINE_SIZE];
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (data[i] != '\n')
+        {
+            if (buffer.size < sizeof(buffer.data))
+            {
+                buffer.data[buffer.size++] = data[i];
+            }
+            else
+            {
+                buffer.isOverflowing = true;
+            }
+            continue;
+        }
+
+        size_t replySize = buffer.isOverflowing ?
+            WriteReply(reply, sizeof(reply), "ERR line-too-long") :
+            HandleControlCommand(std::string_view(buffer.data, buffer.size), reply, sizeof(reply));
+
+        buffer.size = 0;
+        buffer.isOverflowing = false;
+
+        if (!write(reply, replySize))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsControlChannelRunning()
+{
+    return g_isControlChannelRunning.load(std::memory_order_acquire);
+}
+
+bool HasControlChannelFailed()
+{
+    return g_controlChannelThread.joinable() && !g_isControlChannelRunning.load(std::memory_order_acquire);
+}
+
+static void RunControlChannelThread();
+
+// The running flag is set before the server thread starts, and cleared however it exits
+static void LaunchControlChannelThread()
+{
+    g_isControlChannelRunning.store(true, std::memory_order_release);
+    g_controlChannelThread = std::thread([]
+    {
+        RunControlChannelThread();
+        g_isControlChannelRunning.store(false, std::memory_order_release);
+    });
+}
+
+#ifdef _WIN32
+
+/////////////////////
+// Named Pipe Server
+/////////////////////
+
+// Waits for overlapped I/O or the stop event. Returns false if stopped or the I/O failed.
+static bool WaitForPipeIo(OVERLAPPED& overlapped, DWORD& transferred)
+{
+    HANDLE events[2] = { overlapped.hEvent, g_controlChannelStopEvent };
+    if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0)
+    {
+        CancelIo(g_controlChannelPipe);
+        GetOverlappedResult(g_controlChannelPipe, &overlapped, &transferred, TRUE);
+        return false;
+    }
+
+    return GetOverlappedResult(g_controlChannelPipe, &overlapped, &transferred, FALSE) != FALSE;
+}
+
+static bool PipeIoCompleted(BOOL isDone, OVERLAPPED& overlapped, DWORD& transferred)
+{
+    if (isDone)
+    {
+        return GetOverlappedResult(g_controlChannelPipe, &overlapped, &transferred, FALSE) != FALSE;
+    }
+
+    return GetLastError() == ERROR_IO_PENDING && WaitForPipeIo(overlapped, transferred);
+}
+
+static void ServePipeClient(OVERLAPPED& overlapped)
+{
+    ControlLineBuffer buffer = {};
+    char data[CONTROL_CHANNEL_LINE_SIZE];
+
+    auto write = [&overlapped](const char* reply, size_t replySize)
+    {
+        DWORD written = 0;
+        BOOL isDone = WriteFile(g_controlChannelPipe, reply, static_cast<DWORD>(replySize), nullptr, &overlapped);
+        return PipeIoCompleted(isDone, overlapped, written) && written == replySize;
+    };
+
+    for (;;)
+    {
+        DWORD received = 0;
+        BOOL isDone = ReadFile(g_controlChannelPipe, data, sizeof(data), nullptr, &overlapped);
+        if (!PipeIoCompleted(isDone, overlapped, received) || received == 0)
+        {
+            return;
+        }
+
+        if (!ProcessControlBytes(buffer, data, received, write))
+        {
+            return;
+        }
+    }
+}
+
+static void RunControlChannelThread()
+{
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!overlapped.hEvent)
+    {
+        return;
+    }
+
+    while (WaitForSingleObject(g_controlChannelStopEvent, 0) == WAIT_TIMEOUT)
+    {
+        DWORD transferred = 0;
+        BOOL isConnected = ConnectNamedPipe(g_controlChannelPipe, &overlapped);
+        if (!isConnected)
+        {
+            DWORD error = GetLastError();
+            if (error == ERROR_PIPE_CONNECTED)
+            {
+                isConnected = TRUE;
+            }
+            else if (error == ERROR_IO_PENDING)
+            {
+                isConnected = WaitForPipeIo(overlapped, transferred);
+            }
+        }
+
+        if (isConnected)
+        {
+            ServePipeClient(overlapped);
+        }
+
+        DisconnectNamedPipe(g_controlChannelPipe);
+    }
+
+    CloseHandle(overlapped.hEvent);
+}
+
+bool StartControlChannel()
+{
+    if (IsControlChannelRunning())
+    {
+        return true;
+    }
+
+    // A server thread that exited on its own is joined and its endpoint closed first
+    StopControlChannel();
+
+    g_controlChannelStopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!g_controlChannelStopEvent)
+    {
+        return false;
+    }
+
+    g_controlChannelPipe = CreateNamedPipeW(CONTROL_CHANNEL_NAME,
+        PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        1, CONTROL_CHANNEL_LINE_SIZE, CONTROL_CHANNEL_LINE_SIZE, 0, nullptr);
+    if (g_controlChannelPipe == INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(g_controlChannelStopEvent);
+        g_controlChannelStopEvent = nullptr;
+        return false;
+    }
+
+    LaunchControlChannelThread();
+    return true;
+}
+
+void StopControlChannel()
+{
+    if (!g_controlChannelThread.joinable())
+    {
+        return;
+    }
+
+    SetEvent(g_controlChannelStopEvent);
+    g_controlChannelThread.join();
+
+    CloseHandle(g_controlChannelPipe);
+    g_controlChannelPipe = INVALID_HANDLE_VALUE;
+    CloseHandle(g_controlChannelStopEvent);
+    g_controlChannelStopEvent = nullptr;
+}
+
+#else
+
+/////////////////////
+// Unix Domain Socket Server
+/////////////////////
+
+static void ServeSocketClient(int client)
+{
+    ControlLineBuffer buffer = {};
+    char data[CONTROL_CHANNEL_LINE_SIZE];
+
+    auto write = [client](const char* reply, size_t replySize)
+    {
+        return send(client, reply, replySize, MSG_NOSIGNAL) == static_cast<ssize_t>(replySize);
+    };
+
+    for (;;)
+    {
+        ssize_t received = recv(client, data, sizeof(data), 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0 || !ProcessControlBytes(buffer, data, static_cast<size_t>(received), write))
+        {
+            return;
+        }
+    }
+}
+
+static void RunControlChannelThread()
+{
+    while (!g_isControlChannelStopping.load(std::memory_order_acquire))
+    {
+        int client = accept(g_controlChannelSocket, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+
+        // Sequentially consistent with the stop: either this sees the stop flag, or the stop sees the client and shuts it down
+        g_controlChannelClient.store(client, std::memory_order_seq_cst);
+        if (!g_isControlChannelStopping.load(std::memory_order_seq_cst))
+        {
+            ServeSocketClient(client);
+        }
+        g_controlChannelClient.store(-1, std::memory_order_release);
+        close(client);
+    }
+}
+
+bool StartControlChannel()
+{
+    if (IsControlChannelRunning())
+    {
+        return true;
+    }
+
+    // A server thread that exited on its own is joined and its endpoint closed first
+    StopControlChannel();
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", CONTROL_CHANNEL_NAME);
+
+    g_controlChannelSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (g_controlChannelSocket < 0)
+    {
+        return false;
+    }
+
+    unlink(CONTROL_CHANNEL_NAME);
+    if (bind(g_controlChannelSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(g_controlChannelSocket, 1) != 0)
+    {
+        close(g_controlChannelSocket);
+        g_controlChannelSocket = -1;
+        return false;
+    }
+
+    g_isControlChannelStopping.store(false, std::memory_order_release);
+    LaunchControlChannelThread();
+    return true;
+}
+
+void StopControlChannel()
+{
+    if (!g_controlChannelThread.joinable())
+    {
+        return;
+    }
+
+    // Shutting the sockets down wakes accept() and recv() in the server thread
+    g_isControlChannelStopping.store(true, std::memory_order_seq_cst);
+    shutdown(g_controlChannelSocket, SHUT_RDWR);
+    int client = g_controlChannelClient.load(std::memory_order_seq_cst);
+    if (client >= 0)
+    {
+        shutdown(client, SHUT_RDWR);
+    }
+    g_controlChannelThread.join();
+
+    close(g_controlChannelSocket);
+    g_controlChannelSocket = -1;
+    unlink(CONTROL_CHANNEL_NAME);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// The Control Channel is an opt-in local endpoint for automation (e.g. benchmark runs switching modes from outside the game).
+// Windows serves a named pipe, other platforms a Unix domain socket (used by the Linux test builds).
+// One command per line, one reply per line:
+//   GET              -> OK <mode>
+//   SET <mode>       -> QUEUED
+//   PRESET <name>    -> QUEUED
+//   STATS            -> OK key=value ...
+// Errors reply with ERR <reason>. Mutations are queued and applied on the game thread, see CommandQueue.h.
+
+#ifdef _WIN32
+#define CONTROL_CHANNEL_NAME L"\\\\.\\pipe\\dlss-enabler-bridge-2077"
+#else
+#define CONTROL_CHANNEL_NAME "/tmp/dlss-enabler-bridge-2077.sock"
+#endif
+
+constexpr size_t CONTROL_CHANNEL_LINE_SIZE = 256;
+
+// Starts the server thread. Returns false if the endpoint couldn't be created.
+bool StartControlChannel();
+void StopControlChannel();
+bool IsControlChannelRunning();
+
+// The server thread stopped on its own, on an accept or pipe error. Starting the channel again cleans it up first.
+bool HasControlChannelFailed();
+
+// Parses one command line and writes a newline-terminated reply. Returns the reply length.
+size_t HandleControlCommand(std::string_view line, char* reply, size_t replySize);
@@ -0,0 +1,24 @@
+#pragma once
+
+// DLSSEnabler's API
+typedef enum DLSS_ENABLER_FRAMEGENERATION_MODE
+{
+    DLSS_ENABLER_FRAMEGENERATION_DISABLED = 0,
+    DLSS_ENABLER_FRAMEGENERATION_ENABLED = 1,
+    DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED = 2,
+    DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED = 3,
+} DLSS_ENABLER_FRAMEGENERATION_MODE;
+
+typedef enum DLSS_ENABLER_RESULT
+{
+    DLSS_ENABLER_RESULT_SUCCESS = 1,
+    DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED = 0,
+    DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT = -1,
+} DLSS_ENABLER_RESULT;
+
+typedef DLSS_ENABLER_RESULT(*GetFrameGenerationModeFunc)(DLSS_ENABLER_FRAMEGENERATION_MODE& mode);
+typedef DLSS_ENABLER_RESULT(*SetFrameGenerationModeFunc)(DLSS_ENABLER_FRAMEGENERATION_MODE mode);
+
+// Resolved from dlss-enabler.dll by OnInitialize, nullptr when not available
+extern GetFrameGenerationModeFunc g_GetFrameGenerationModeFunc;
+extern SetFrameGenerationModeFunc g_SetFrameGenerationModeFunc;
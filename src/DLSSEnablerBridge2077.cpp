@@ -1,7 +1,22 @@
 #include "DLSSEnablerBridge2077.h"
+#include "Batch.h"
+#include "CommandQueue.h"
+#include "ControlChannel.h"
+#include "Config.h"
+#include "Handlers.h"
+#include "ModeCache.h"
+#include "NativeApi.h"
+#include "ProfileStore.h"
+#include "SafePoint.h"
+#include "StatusPage.h"
+#include "TransitionProbe.h"
 #include <windows.h>
+#include <chrono>
+#include <cstring>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 #include <RED4ext/RED4ext.hpp>
 
 // Global variables
@@ -10,61 +25,130 @@ RED4ext::PluginHandle pluginHandle;
 HMODULE hDll;
 GetFrameGenerationModeFunc g_GetFrameGenerationModeFunc = nullptr;
 SetFrameGenerationModeFunc g_SetFrameGenerationModeFunc = nullptr;
-std::string g_lastLoggedMessage;
-bool g_isLoggingDisabled = false;
-bool g_isLastMessageRepeated = false;
-bool g_deBridgeDebug = false;
-bool g_deBridgeDebugExt = false;
+bool g_deBridgeDebugArg = false;
+bool g_deBridgeDebugExtArg = false;
+bool g_deBridgeIpcArg = false;
+bool g_deBridgeProbeArg = false;
+uint64_t g_appliedConfigGeneration = 0;
+uint32_t g_profileSubscription = 0;
+std::chrono::steady_clock::time_point g_nextControlChannelRestart;
+char g_dllVersionString[32] = "Unknown";
+std::atomic<InitState> g_initState{ InitState::Pending };
+std::thread g_initThread;
 
 // Constants
 const wchar_t* DLSS_ENABLER_DLL_NAME = L"dlss-enabler.dll";
-const char* LOG_MSG_CALLED = "Called!";
-const char* LOG_MSG_CALLED_SHOULD_ENABLE = "Called with shouldEnable = %s";
-const char* LOG_MSG_COMPLETED = "Completed";
-const char* LOG_MSG_DISABLED = "Disabled";
-const char* LOG_MSG_ENABLED = "Enabled";
-const char* LOG_MSG_GAME_NOT_READY = "The game is paused, or in the main menu. Communication with DLSS Enabler is halted.";
-const char* LOG_MSG_FALSE = "false";
-const char* LOG_MSG_FUNC_ADDR_FAILED = "Failed to get function addresses. Error code: %lu";
-const char* LOG_MSG_FUNC_GET_ADDR_FAILED = "Failed to get GetFrameGenerationMode function address. Error code: %lu";
-const char* LOG_MSG_FUNC_SET_ADDR_FAILED = "Failed to get SetFrameGenerationMode function address. Error code: %lu";
-const char* LOG_MSG_NULL_OUTPUT = "Output parameter is null";
-const char* LOG_MSG_TRUE = "true";
-const char* LOG_MSG_UNKNOWN = "Unknown";
+const std::chrono::seconds CONTROL_CHANNEL_RESTART_INTERVAL(1);
 
 ////////////////////////
-// Restrict Logging: in case the modded Frame Generation goes *^(!$^% or methods are called excessively when FG is turned off in the game settings
+// Logging: messages formatted by the logging macros go to the RED4ext log
 ////////////////////////
 
-bool ShouldLog(const std::string& message) 
+void WriteLog(LogSeverity severity, const char* message)
 {
-    if (g_isLoggingDisabled) {
+    switch (severity)
+    {
+    case LogSeverity::Info:
+        sdk->logger->InfoF(pluginHandle, "%s", message);
+        break;
+    case LogSeverity::Warn:
+        sdk->logger->WarnF(pluginHandle, "%s", message);
+        break;
+    case LogSeverity::Error:
+        sdk->logger->ErrorF(pluginHandle, "%s", message);
+        break;
+    }
+}
+
+////////////////////////
+// DLL Version: read once on initialization, the getter only copies the cached string
+////////////////////////
+
+bool ReadDLLVersion(uint16_t version[4])
+{
+    DWORD verSize = GetFileVersionInfoSizeW(DLSS_ENABLER_DLL_NAME, NULL);
+    if (verSize == 0)
+    {
+        DWORD error = GetLastError();
+        LOG_ERROR("Failed to get DLL version info. Error code: %lu", error);
         return false;
     }
 
-    if (message == g_lastLoggedMessage) {
-        if (!g_isLastMessageRepeated) {
-            g_isLastMessageRepeated = true;
-            return true;
-        }
+    std::vector<char> verData(verSize);
+    if (!GetFileVersionInfoW(DLSS_ENABLER_DLL_NAME, 0, verSize, verData.data()))
+    {
+        return false;
+    }
+
+    UINT size = 0;
+    VS_FIXEDFILEINFO* verInfo = nullptr;
+    if (!VerQueryValueW(verData.data(), L"\\", (VOID FAR * FAR*) & verInfo, &size))
+    {
         return false;
     }
-    else {
-        g_lastLoggedMessage = message;
-        g_isLastMessageRepeated = false;
-        return true;
+
+    if (size < sizeof(VS_FIXEDFILEINFO) || verInfo->dwSignature != 0xfeef04bd)
+    {
+        return false;
     }
+
+    version[0] = HIWORD(verInfo->dwFileVersionMS);
+    version[1] = LOWORD(verInfo->dwFileVersionMS);
+    version[2] = HIWORD(verInfo->dwFileVersionLS);
+    version[3] = LOWORD(verInfo->dwFileVersionLS);
+    return true;
 }
 
 /////////////////////
 // Initialize / Uninitialize
 /////////////////////
 
-bool OnInitialize()
+void OnInitialize()
 {
-    g_lastLoggedMessage = "";
-    g_isLoggingDisabled = false;
-    g_isLastMessageRepeated = false;
+    ResetLogState();
+
+    ResetModeCache();
+
+    if (!OpenStatusPage())
+    {
+        LOG_WARN("Failed to open the shared memory status page. Error code: %lu", GetLastError());
+    }
+
+    // Loading dlss-enabler.dll runs its own initialization, which shouldn't hold up the game's loading thread
+    g_initState.store(InitState::Pending, std::memory_order_release);
+    g_initThread = std::thread([]
+    {
+        auto start = std::chrono::steady_clock::now();
+        bool isInitialized = InitializeDLSSEnabler();
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (isInitialized)
+        {
+            sdk->logger->InfoF(pluginHandle, "DLSS Enabler initialized in %.2f ms in the background", elapsedUs / 1000.0);
+        }
+        else
+        {
+            sdk->logger->ErrorF(pluginHandle, "Failed to initialize after %.2f ms. Plugin may not function correctly.", elapsedUs / 1000.0);
+        }
+
+        g_initState.store(isInitialized ? InitState::Ready : InitState::Failed, std::memory_order_release);
+    });
+}
+
+// Initialization thread only. Everything written here is published to the game thread by the store to g_initState,
+// and to the Mode Cache's other callers by SetLoadedState.
+bool InitializeDLSSEnabler()
+{
+    uint16_t version[4] = {};
+    if (ReadDLLVersion(version))
+    {
+        sprintf_s(g_dllVersionString, "%d.%d.%d.%d", version[0], version[1], version[2], version[3]);
+    }
+    else
+    {
+        strcpy_s(g_dllVersionString, LOG_MSG_UNKNOWN);
+    }
+    LOG_DEBUG("DLL version: %s", g_dllVersionString);
 
     hDll = LoadLibraryW(DLSS_ENABLER_DLL_NAME);
     if (!hDll)
@@ -76,18 +160,32 @@ bool OnInitialize()
 
     LOG_DEBUG("dlss-enabler.dll loaded successfully");
 
+    // Probe each export on its own, so the log tells which one an older DLSS Enabler is missing
     g_GetFrameGenerationModeFunc = (GetFrameGenerationModeFunc)GetProcAddress(hDll, "GetFrameGenerationMode");
+    if (!g_GetFrameGenerationModeFunc)
+    {
+        DWORD error = GetLastError();
+        LOG_ERROR(LOG_MSG_FUNC_GET_ADDR_FAILED, error);
+    }
+
     g_SetFrameGenerationModeFunc = (SetFrameGenerationModeFunc)GetProcAddress(hDll, "SetFrameGenerationMode");
+    if (!g_SetFrameGenerationModeFunc)
+    {
+        DWORD error = GetLastError();
+        LOG_ERROR(LOG_MSG_FUNC_SET_ADDR_FAILED, error);
+    }
 
     if (!g_GetFrameGenerationModeFunc || !g_SetFrameGenerationModeFunc)
     {
-        DWORD error = GetLastError();
-        LOG_ERROR(LOG_MSG_FUNC_ADDR_FAILED, error);
+        g_GetFrameGenerationModeFunc = nullptr;
+        g_SetFrameGenerationModeFunc = nullptr;
         FreeLibrary(hDll);
         hDll = nullptr;
         return false;
     }
 
+    SetLoadedState(true, version);
+
     LOG_DEBUG("Plugin has loaded successfully");
 
     return true;
@@ -95,9 +193,18 @@ bool OnInitialize()
 
 void OnUninitialize()
 {
-    g_lastLoggedMessage = "";
-    g_isLoggingDisabled = false;
-    g_isLastMessageRepeated = false;
+    // LoadLibraryW can't be cancelled, wait for it before unloading anything
+    if (g_initThread.joinable())
+    {
+        g_initThread.join();
+    }
+    g_initState.store(InitState::Pending, std::memory_order_release);
+
+    ResetLogState();
+
+    ClearCommandQueue();
+    ResetModeCache();
+    CloseStatusPage();
 
     if (hDll)
     {
@@ -110,20 +217,134 @@ void OnUninitialize()
     LOG_DEBUG("Plugin unloading...");
 }
 
+////////////////////////
+// Config: loaded from the file next to the plugin, launch parameters always win over it
+////////////////////////
+
+std::filesystem::path GetPluginFilePath(const wchar_t* fileName)
+{
+    HMODULE module = nullptr;
+    wchar_t modulePath[MAX_PATH];
+
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, reinterpret_cast<LPCWSTR>(&GetPluginFilePath), &module) ||
+        GetModuleFileNameW(module, modulePath, MAX_PATH) == 0)
+    {
+        return fileName;
+    }
+
+    return std::filesystem::path(modulePath).replace_filename(fileName);
+}
+
+// Game thread only: flags read by every handler are never changed under them
+void ApplyConfig()
+{
+    uint64_t generation = GetConfigGeneration();
+    if (generation == g_appliedConfigGeneration)
+    {
+        return;
+    }
+    g_appliedConfigGeneration = generation;
+
+    const BridgeConfig& config = GetConfig();
+
+    g_deBridgeDebug.store(g_deBridgeDebugArg || config.logLevel == LogLevel::Debug, std::memory_order_relaxed);
+    g_deBridgeDebugExt.store(g_deBridgeDebugExtArg || config.logLevel == LogLevel::DebugExt, std::memory_order_relaxed);
+
+    if (GetConfigErrorCount() > 0)
+    {
+        LOG_ERROR("Config has %u invalid line(s), first at line %u. Defaults are used for them.", GetConfigErrorCount(), GetConfigFirstErrorLine());
+    }
+
+    LOG_DEBUG("Config applied. Cache TTL: %u ms, queue mode: %s, default preset: %s",
+        config.cacheTtlMs,
+        config.queueMode == QueueMode::Coalesce ? "coalesce" : "fifo",
+        config.defaultPreset[0] ? config.defaultPreset : "none");
+
+    if (g_deBridgeProbeArg || config.isTransitionProbeEnabled)
+    {
+        if (!IsTransitionProbeRunning() && StartTransitionProbe())
+        {
+            LOG_DEBUG("Transition probe started");
+        }
+    }
+    else if (IsTransitionProbeRunning())
+    {
+        StopTransitionProbe();
+        LOG_DEBUG("Transition probe stopped");
+    }
+
+    UpdateControlChannel();
+}
+
+// Game thread only: starts or stops the control channel as configured, a channel that failed is started again
+void UpdateControlChannel()
+{
+    if (g_deBridgeIpcArg || GetConfig().isControlChannelEnabled)
+    {
+        if (IsControlChannelRunning())
+        {
+            return;
+        }
+
+        if (StartControlChannel())
+        {
+            LOG_DEBUG("Control channel started");
+        }
+        else
+        {
+            DWORD error = GetLastError();
+            LOG_ERROR("Failed to start the control channel. Error code: %lu", error);
+        }
+    }
+    else if (IsControlChannelRunning() || HasControlChannelFailed())
+    {
+        StopControlChannel();
+        LOG_DEBUG("Control channel stopped");
+    }
+}
+
+////////////////////////
+// Profiles: mode changes are recorded for the save slot and context, SafePoint applies and writes them
+////////////////////////
+
+static void OnProfileModeChanged(int32_t newMode, int32_t oldMode, void* userData)
+{
+    RED4EXT_UNUSED_PARAMETER(oldMode);
+    RED4EXT_UNUSED_PARAMETER(userData);
+
+    if (GetConfig().isProfileStoreEnabled)
+    {
+        RecordProfileMode(newMode);
+    }
+}
+
+static void OnProfileModeSet(int32_t expectedMode, void* userData)
+{
+    RED4EXT_UNUSED_PARAMETER(userData);
+
+    if (GetConfig().isProfileStoreEnabled)
+    {
+        RecordProfileSetMode(expectedMode);
+    }
+}
+
 ////////////////////////
 // Check The Game: is the game ready to use the API?
 ////////////////////////
 
-bool IsGameReady()
+// Not ready until the initialization thread is done, after that its results can be read here
+static GameReadiness CheckGameReadiness()
 {
-    LOG_DEBUG_EXT(LOG_MSG_CALLED);
+    if (g_initState.load(std::memory_order_acquire) == InitState::Pending)
+    {
+        return GameReadiness::Initializing;
+    }
 
     auto gameInstance = RED4ext::CGameEngine::Get()->framework->gameInstance;
 
     if (!gameInstance)
     {
-        LOG_WARN(LOG_MSG_GAME_NOT_READY);
-        return false;
+        return GameReadiness::Paused;
     }
 
     auto rtti = RED4ext::CRTTISystem::Get();
@@ -136,8 +357,7 @@ bool IsGameReady()
 
     if (!instance)
     {
-        LOG_WARN(LOG_MSG_GAME_NOT_READY);
-        return false;
+        return GameReadiness::Paused;
     }
 
     auto inkSysReqHandCls = rtti->GetClass("inkISystemRequestsHandler");
@@ -147,18 +367,59 @@ bool IsGameReady()
     RED4ext::ExecuteFunction(instance, inkSysReqHandCls->GetFunction("IsPreGame"), &isPreGame);
     RED4ext::ExecuteFunction(instance, inkSysReqHandCls->GetFunction("IsGamePaused"), &isGamePaused);
 
-    bool isReady = !isPreGame && !isGamePaused;
-    if (isReady)
+    if (isPreGame)
+    {
+        return GameReadiness::MainMenu;
+    }
+    return isGamePaused ? GameReadiness::Paused : GameReadiness::Ready;
+}
+
+bool IsGameReady()
+{
+    LOG_DEBUG_EXT(LOG_MSG_CALLED);
+
+    GameReadiness readiness = CheckGameReadiness();
+    ReportGameReadiness(readiness);
+
+    if (readiness == GameReadiness::Ready)
     {
         LOG_DEBUG_EXT("The game should be ready for API communication, if running in the normal mode.");
     }
     else
     {
-        LOG_WARN(LOG_MSG_GAME_NOT_READY);
+        LOG_WARN(readiness == GameReadiness::Initializing ? LOG_MSG_INITIALIZING : LOG_MSG_GAME_NOT_READY);
     }
 
     LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
-    return isReady;
+    return readiness == GameReadiness::Ready;
+}
+
+////////////////////////
+// Safe Point: the platform-neutral part lives in SafePoint, readiness is checked here through RTTI
+////////////////////////
+
+bool OnRunningUpdate(RED4ext::CGameApplication* aApp)
+{
+    RED4EXT_UNUSED_PARAMETER(aApp);
+
+    ApplyConfig();
+
+    // The control channel's server thread stops on an accept or pipe error, it's restarted once a second at most
+    if (HasControlChannelFailed())
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= g_nextControlChannelRestart)
+        {
+            g_nextControlChannelRestart = now + CONTROL_CHANNEL_RESTART_INTERVAL;
+            LOG_ERROR("The control channel stopped, restarting it");
+            UpdateControlChannel();
+        }
+    }
+
+    RunSafePoint(&CheckGameReadiness);
+
+    // Stay in the Running state
+    return false;
 }
 
 /////////////////////
@@ -170,44 +431,18 @@ void DLSSEnabler_GetVersionAsString(RED4ext::IScriptable* aContext, RED4ext::CSt
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(aFrame);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     LOG_DEBUG_EXT(LOG_MSG_CALLED);
 
-    std::string versionStr = LOG_MSG_UNKNOWN;
+    // The version is read by the initialization thread
+    const char* versionString = g_initState.load(std::memory_order_acquire) == InitState::Pending ? LOG_MSG_UNKNOWN : g_dllVersionString;
 
-    DWORD verSize = GetFileVersionInfoSizeW(DLSS_ENABLER_DLL_NAME, NULL);
-    if (verSize != 0)
-    {
-        std::vector<char> verData(verSize);
-        if (GetFileVersionInfoW(DLSS_ENABLER_DLL_NAME, 0, verSize, verData.data()))
-        {
-            UINT size = 0;
-            VS_FIXEDFILEINFO* verInfo = nullptr;
-            if (VerQueryValueW(verData.data(), L"\\", (VOID FAR * FAR*) & verInfo, &size))
-            {
-                if (size >= sizeof(VS_FIXEDFILEINFO) && verInfo->dwSignature == 0xfeef04bd)
-                {
-                    char szVersion[32];
-                    sprintf_s(szVersion, "%d.%d.%d.%d",
-                        HIWORD(verInfo->dwFileVersionMS),
-                        LOWORD(verInfo->dwFileVersionMS),
-                        HIWORD(verInfo->dwFileVersionLS),
-                        LOWORD(verInfo->dwFileVersionLS));
-                    versionStr = szVersion;
-                }
-            }
-        }
-        LOG_DEBUG("DLL version: %s", versionStr.c_str());
-    }
-    else
-    {
-        DWORD error = GetLastError();
-        LOG_ERROR("Failed to get DLL version info. Error code: %lu", error);
-    }
+    LOG_DEBUG("DLL version: %s", versionString);
 
     if (aOut)
     {
-        *aOut = RED4ext::CString(std::string_view(versionStr));
+        *aOut = RED4ext::CString(versionString);
     }
     else
     {
@@ -222,6 +457,7 @@ void DLSSEnabler_GetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(aFrame);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     LOG_DEBUG_EXT(LOG_MSG_CALLED);
 
@@ -240,35 +476,8 @@ void DLSSEnabler_GetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
     }
 
     DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
-    DLSS_ENABLER_RESULT result = g_GetFrameGenerationModeFunc(currentMode);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    if (HandleGetFrameGenerationMode(currentMode))
     {
-        if (g_deBridgeDebug)
-        {
-            const char* modeString;
-            switch (currentMode)
-            {
-            case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
-                modeString = "FG Disabled; DFG Disabled";
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
-                modeString = "FG Enabled; DFG Disabled";
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
-                modeString = "FG Disabled; DFG Enabled";
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
-                modeString = "FG Enabled; DFG Enabled";
-                break;
-            default:
-                modeString = LOG_MSG_UNKNOWN;
-            }
-
-            LOG_DEBUG("Current Frame Generation Mode: %d", currentMode);
-            LOG_DEBUG("Current Frame Generation Status: %s", modeString);
-        }
-
         if (aOut)
         {
             *aOut = currentMode;
@@ -280,7 +489,6 @@ void DLSSEnabler_GetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
     }
     else
     {
-        LOG_ERROR("Failed to get Frame Generation Mode. Result: %d", result);
         if (aOut) *aOut = DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
     }
 
@@ -292,6 +500,7 @@ void DLSSEnabler_GetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(aFrame);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     LOG_DEBUG_EXT(LOG_MSG_CALLED);
 
@@ -309,32 +518,12 @@ void DLSSEnabler_GetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext
         return;
     }
 
-    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
-    DLSS_ENABLER_RESULT result = g_GetFrameGenerationModeFunc(currentMode);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    bool isEnabled;
+    if (HandleGetFrameGenerationState(isEnabled))
     {
-        if (g_deBridgeDebug)
-        {
-            const char* modeString;
-            switch (currentMode)
-            {
-            case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
-                modeString = LOG_MSG_ENABLED;
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
-                modeString = LOG_MSG_DISABLED;
-                break;
-            default:
-                modeString = LOG_MSG_UNKNOWN;
-            }
-
-            LOG_DEBUG("Current Frame Generation State: %s", modeString);
-        }
-
         if (aOut)
         {
-            *aOut = (currentMode == DLSS_ENABLER_FRAMEGENERATION_ENABLED);
+            *aOut = isEnabled;
         }
         else
         {
@@ -343,7 +532,6 @@ void DLSSEnabler_GetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext
     }
     else
     {
-        LOG_ERROR("Failed to get Frame Generation State. Result: %d", result);
         if (aOut) *aOut = false;
     }
 
@@ -355,6 +543,7 @@ void DLSSEnabler_GetDynamicFrameGenerationState(RED4ext::IScriptable* aContext,
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(aFrame);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     LOG_DEBUG_EXT(LOG_MSG_CALLED);
 
@@ -372,38 +561,12 @@ void DLSSEnabler_GetDynamicFrameGenerationState(RED4ext::IScriptable* aContext,
         return;
     }
 
-    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
-    DLSS_ENABLER_RESULT result = g_GetFrameGenerationModeFunc(currentMode);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    bool isEnabled;
+    if (HandleGetDynamicFrameGenerationState(isEnabled))
     {
-        if (g_deBridgeDebug)
-        {
-            const char* modeString;
-            switch (currentMode)
-            {
-            case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
-                modeString = LOG_MSG_ENABLED;
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
-                modeString = LOG_MSG_ENABLED;
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
-                modeString = LOG_MSG_DISABLED;
-                break;
-            case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
-                modeString = LOG_MSG_DISABLED;
-                break;
-            default:
-                modeString = LOG_MSG_UNKNOWN;
-            }
-
-            LOG_DEBUG("Current Dynamic Frame Generation State: %s", modeString);
-        }
-
         if (aOut)
         {
-            *aOut = (currentMode == DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED || currentMode == DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED);
+            *aOut = isEnabled;
         }
         else
         {
@@ -412,7 +575,6 @@ void DLSSEnabler_GetDynamicFrameGenerationState(RED4ext::IScriptable* aContext,
     }
     else
     {
-        LOG_ERROR("Failed to get Dynamic Frame Generation State. Result: %d", result);
         if (aOut) *aOut = false;
     }
 
@@ -427,6 +589,7 @@ void DLSSEnabler_SetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
 {
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     if (!IsGameReady())
     {
@@ -456,20 +619,8 @@ void DLSSEnabler_SetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
         return;
     }
 
-    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
-
-    DLSS_ENABLER_RESULT result = g_SetFrameGenerationModeFunc(modeValue);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
-    {
-        LOG_DEBUG("Frame Generation mode set successfully: %d", newMode);
-        if (aOut) *aOut = true;
-    }
-    else
-    {
-        LOG_ERROR("Failed to set Frame Generation Mode. Result: %d", result);
-        if (aOut) *aOut = false;
-    }
+    bool isSet = HandleSetFrameGenerationMode(modeValue);
+    if (aOut) *aOut = isSet;
 
     LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
 }
@@ -478,6 +629,7 @@ void DLSSEnabler_SetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext
 {
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     if (!IsGameReady())
     {
@@ -499,21 +651,8 @@ void DLSSEnabler_SetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext
         return;
     }
 
-    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
-
-    DLSS_ENABLER_FRAMEGENERATION_MODE newMode = shouldEnable ? DLSS_ENABLER_FRAMEGENERATION_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DISABLED;
-    DLSS_ENABLER_RESULT result = g_SetFrameGenerationModeFunc(newMode);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
-    {
-        LOG_DEBUG("Frame Generation set to %s", shouldEnable ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
-        if (aOut) *aOut = true;
-    }
-    else
-    {
-        LOG_ERROR("Failed to set Frame Generation. Result: %d", result);
-        if (aOut) *aOut = false;
-    }
+    bool isSet = HandleSetFrameGenerationState(shouldEnable);
+    if (aOut) *aOut = isSet;
 
     LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
 }
@@ -522,6 +661,7 @@ void DLSSEnabler_SetDynamicFrameGenerationState(RED4ext::IScriptable* aContext,
 {
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     if (!IsGameReady())
     {
@@ -543,21 +683,8 @@ void DLSSEnabler_SetDynamicFrameGenerationState(RED4ext::IScriptable* aContext,
         return;
     }
 
-    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
-
-    DLSS_ENABLER_FRAMEGENERATION_MODE newMode = shouldEnable ? DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED;
-    DLSS_ENABLER_RESULT result = g_SetFrameGenerationModeFunc(newMode);
-
-    if (result == DLSS_ENABLER_RESULT_SUCCESS)
-    {
-        LOG_DEBUG("Dynamic Frame Generation set to %s", shouldEnable ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
-        if (aOut) *aOut = true;
-    }
-    else
-    {
-        LOG_ERROR("Failed to set Dynamic Frame Generation. Result: %d", result);
-        if (aOut) *aOut = false;
-    }
+    bool isSet = HandleSetDynamicFrameGenerationState(shouldEnable);
+    if (aOut) *aOut = isSet;
 
     LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
 }
@@ -571,6 +698,7 @@ void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4
     RED4EXT_UNUSED_PARAMETER(aContext);
     RED4EXT_UNUSED_PARAMETER(aFrame);
     RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
 
     LOG_DEBUG_EXT(LOG_MSG_CALLED);
 
@@ -591,7 +719,7 @@ void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4
     LOG_DEBUG_EXT("Function addresses obtained successfully");
 
     DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
-    DLSS_ENABLER_RESULT result = g_GetFrameGenerationModeFunc(currentMode);
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
 
     if (result != DLSS_ENABLER_RESULT_SUCCESS)
     {
@@ -604,7 +732,7 @@ void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4
 
     if (currentMode == DLSS_ENABLER_FRAMEGENERATION_DISABLED)
     {
-        result = g_SetFrameGenerationModeFunc(DLSS_ENABLER_FRAMEGENERATION_ENABLED);
+        result = ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_ENABLED);
         if (result == DLSS_ENABLER_RESULT_SUCCESS)
         {
             LOG_DEBUG("Frame Generation set to Enabled");
@@ -618,7 +746,7 @@ void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4
     }
     else if (currentMode == DLSS_ENABLER_FRAMEGENERATION_ENABLED)
     {
-        result = g_SetFrameGenerationModeFunc(DLSS_ENABLER_FRAMEGENERATION_DISABLED);
+        result = ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_DISABLED);
         if (result == DLSS_ENABLER_RESULT_SUCCESS)
         {
             LOG_DEBUG("Frame Generation set to Disabled");
@@ -639,6 +767,226 @@ void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4
     LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
 }
 
+/////////////////////
+// Batch
+/////////////////////
+
+void DLSSEnabler_RunBatch(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
+
+    RED4ext::DynArray<int32_t> ops;
+    RED4ext::GetParameter(aFrame, &ops);
+    aFrame->code++; // skip ParamEnd
+
+    LOG_DEBUG_EXT("Called with %u operation(s)", ops.size);
+
+    if (!aOut)
+    {
+        LOG_WARN(LOG_MSG_NULL_OUTPUT);
+        return;
+    }
+
+    uint32_t count = ops.size < BATCH_MAX_OPS ? ops.size : BATCH_MAX_OPS;
+    int32_t results[BATCH_MAX_OPS];
+    uint32_t failed = 0;
+
+    // One readiness check for the whole batch
+    if (IsGameReady())
+    {
+        failed = RunBatch(ops.entries, count, results);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            results[i] = BATCH_RESULT_NOT_READY;
+        }
+        failed = count;
+    }
+
+    aOut->Clear();
+    aOut->Reserve(ops.size);
+    for (uint32_t i = 0; i < ops.size; ++i)
+    {
+        aOut->PushBack(i < count ? results[i] : BATCH_RESULT_BAD_ARGUMENT);
+    }
+
+    if (ops.size > count)
+    {
+        LOG_ERROR("Batch has %u operations, only the first %u were run", ops.size, BATCH_MAX_OPS);
+    }
+    else if (failed > 0)
+    {
+        LOG_WARN("%u of %u batch operation(s) failed", failed, count);
+    }
+    else
+    {
+        LOG_DEBUG("%u batch operation(s) completed", count);
+    }
+
+    LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
+}
+
+/////////////////////
+// Transition Probe
+/////////////////////
+
+void DLSSEnabler_GetTransitionLatencyHistogram(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(aFrame);
+    RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
+
+    LOG_DEBUG_EXT(LOG_MSG_CALLED);
+
+    if (!aOut)
+    {
+        LOG_WARN(LOG_MSG_NULL_OUTPUT);
+        return;
+    }
+
+    uint32_t buckets[TRANSITION_HISTOGRAM_BUCKETS];
+    GetTransitionHistogram(buckets);
+
+    aOut->Clear();
+    for (uint32_t bucket : buckets)
+    {
+        aOut->PushBack(static_cast<int32_t>(bucket));
+    }
+
+    LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
+}
+
+void DLSSEnabler_GetTransitionProbeStats(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(aFrame);
+    RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
+
+    LOG_DEBUG_EXT(LOG_MSG_CALLED);
+
+    if (!aOut)
+    {
+        LOG_WARN(LOG_MSG_NULL_OUTPUT);
+        return;
+    }
+
+    TransitionStats stats = GetTransitionStats();
+
+    aOut->Clear();
+    aOut->PushBack(static_cast<int32_t>(stats.samples));
+    aOut->PushBack(static_cast<int32_t>(stats.reverted));
+    aOut->PushBack(static_cast<int32_t>(stats.timedOut));
+    aOut->PushBack(static_cast<int32_t>(stats.superseded));
+    aOut->PushBack(static_cast<int32_t>(stats.lastLatencyUs));
+
+    LOG_DEBUG("Transitions: %u measured, %u reverted, %u timed out, %u superseded. Last latency: %u us",
+        stats.samples, stats.reverted, stats.timedOut, stats.superseded, stats.lastLatencyUs);
+
+    LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
+}
+
+/////////////////////
+// Profiles
+/////////////////////
+
+void DLSSEnabler_SetProfileSlot(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
+
+    RED4ext::CString slotName;
+    RED4ext::GetParameter(aFrame, &slotName);
+    aFrame->code++; // skip ParamEnd
+
+    LOG_DEBUG_EXT("Called with slotName = %s", slotName.c_str());
+
+    if (!GetConfig().isProfileStoreEnabled)
+    {
+        LOG_WARN("Profiles are disabled in the config");
+        if (aOut) *aOut = false;
+        return;
+    }
+
+    // Reporting a slot means a session started with it, the stored mode is applied even if the slot didn't change
+    SetProfileSlot(slotName.c_str());
+    RequestProfileApply();
+
+    if (aOut) *aOut = true;
+
+    LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
+}
+
+void DLSSEnabler_SetProfileContext(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(a4);
+    ALLOC_AUDIT_SCOPE();
+
+    int32_t context;
+    RED4ext::GetParameter(aFrame, &context);
+    aFrame->code++; // skip ParamEnd
+
+    LOG_DEBUG_EXT("Called with context = %d", context);
+
+    if (context < 0 || context >= static_cast<int32_t>(GAME_CONTEXT_COUNT))
+    {
+        LOG_ERROR("Invalid context value: %d", context);
+        if (aOut) *aOut = false;
+        return;
+    }
+
+    if (!GetConfig().isProfileStoreEnabled)
+    {
+        LOG_WARN("Profiles are disabled in the config");
+        if (aOut) *aOut = false;
+        return;
+    }
+
+    SetProfileContext(static_cast<GameContext>(context));
+
+    if (aOut) *aOut = true;
+
+    LOG_DEBUG_EXT(LOG_MSG_COMPLETED);
+}
+
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+
+/////////////////////
+// Allocation Audit
+/////////////////////
+
+static void ReportAllocationAuditViolation(const char* handlerName, uint64_t allocations)
+{
+    LOG_ERROR("%s allocated %llu time(s) after warm-up", handlerName, static_cast<unsigned long long>(allocations));
+}
+
+void DLSSEnabler_GetAllocationAuditViolations(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, int32_t* aOut, int64_t a4)
+{
+    RED4EXT_UNUSED_PARAMETER(aContext);
+    RED4EXT_UNUSED_PARAMETER(aFrame);
+    RED4EXT_UNUSED_PARAMETER(a4);
+
+    if (aOut) *aOut = static_cast<int32_t>(GetAllocAuditViolations());
+}
+
+#endif
+
+/////////////////////
+// Native API
+/////////////////////
+
+RED4EXT_C_EXPORT const DEBridge_Api* RED4EXT_CALL DEBridge_GetApi(uint32_t requestedVersion)
+{
+    return GetNativeApi(requestedVersion);
+}
+
 /////////////////////
 // Registers
 /////////////////////
@@ -693,6 +1041,41 @@ RED4EXT_C_EXPORT void RED4EXT_CALL PostRegisterTypes()
     toggleFunc->SetReturnType("Bool");
     rtti->RegisterFunction(toggleFunc);
     LOG_DEBUG("DLSSEnabler_ToggleFrameGenerationState Registered!");
+
+    auto runBatchFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_RunBatch", "DLSSEnabler_RunBatch", &DLSSEnabler_RunBatch);
+    runBatchFunc->AddParam("array:Int32", "ops");
+    runBatchFunc->SetReturnType("array:Int32");
+    rtti->RegisterFunction(runBatchFunc);
+    LOG_DEBUG("DLSSEnabler_RunBatch Registered!");
+
+    auto getHistogramFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_GetTransitionLatencyHistogram", "DLSSEnabler_GetTransitionLatencyHistogram", &DLSSEnabler_GetTransitionLatencyHistogram);
+    getHistogramFunc->SetReturnType("array:Int32");
+    rtti->RegisterFunction(getHistogramFunc);
+    LOG_DEBUG("DLSSEnabler_GetTransitionLatencyHistogram Registered!");
+
+    auto getProbeStatsFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_GetTransitionProbeStats", "DLSSEnabler_GetTransitionProbeStats", &DLSSEnabler_GetTransitionProbeStats);
+    getProbeStatsFunc->SetReturnType("array:Int32");
+    rtti->RegisterFunction(getProbeStatsFunc);
+    LOG_DEBUG("DLSSEnabler_GetTransitionProbeStats Registered!");
+
+    auto setProfileSlotFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_SetProfileSlot", "DLSSEnabler_SetProfileSlot", &DLSSEnabler_SetProfileSlot);
+    setProfileSlotFunc->AddParam("String", "slotName");
+    setProfileSlotFunc->SetReturnType("Bool");
+    rtti->RegisterFunction(setProfileSlotFunc);
+    LOG_DEBUG("DLSSEnabler_SetProfileSlot Registered!");
+
+    auto setProfileContextFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_SetProfileContext", "DLSSEnabler_SetProfileContext", &DLSSEnabler_SetProfileContext);
+    setProfileContextFunc->AddParam("Int32", "context");
+    setProfileContextFunc->SetReturnType("Bool");
+    rtti->RegisterFunction(setProfileContextFunc);
+    LOG_DEBUG("DLSSEnabler_SetProfileContext Registered!");
+
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+    auto getAuditViolationsFunc = RED4ext::CGlobalFunction::Create("DLSSEnabler_GetAllocationAuditViolations", "DLSSEnabler_GetAllocationAuditViolations", &DLSSEnabler_GetAllocationAuditViolations);
+    getAuditViolationsFunc->SetReturnType("Int32");
+    rtti->RegisterFunction(getAuditViolationsFunc);
+    LOG_DEBUG("DLSSEnabler_GetAllocationAuditViolations Registered!");
+#endif
 }
 
 /////////////////////
@@ -704,18 +1087,34 @@ RED4EXT_C_EXPORT bool RED4EXT_CALL Main(RED4ext::PluginHandle aHandle, RED4ext::
     sdk = aSdk;
     pluginHandle = aHandle;
 
-    g_deBridgeDebug = false;
-    g_deBridgeDebugExt = false;
+    g_deBridgeDebug.store(false, std::memory_order_relaxed);
+    g_deBridgeDebugExt.store(false, std::memory_order_relaxed);
+    g_deBridgeDebugArg = false;
+    g_deBridgeDebugExtArg = false;
+    g_deBridgeIpcArg = false;
+    g_deBridgeProbeArg = false;
 
     switch (aReason)
     {
     case RED4ext::EMainReason::Load:
     {
+        auto loadStart = std::chrono::steady_clock::now();
+
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+        InstallAllocAudit(&ReportAllocationAuditViolation);
+#endif
+
         auto rtti = RED4ext::CRTTISystem::Get();
 
         rtti->AddRegisterCallback(RegisterTypes);
         rtti->AddPostRegisterCallback(PostRegisterTypes);
 
+        RED4ext::GameState runningState;
+        runningState.OnEnter = nullptr;
+        runningState.OnUpdate = &OnRunningUpdate;
+        runningState.OnExit = nullptr;
+        aSdk->gameStates->Add(aHandle, RED4ext::EGameStateType::Running, &runningState);
+
         int argc = 0;
         LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
         if (argv != nullptr)
@@ -724,29 +1123,69 @@ RED4EXT_C_EXPORT bool RED4EXT_CALL Main(RED4ext::PluginHandle aHandle, RED4ext::
             {
                 if (wcscmp(argv[i], L"--de-bridge-debug") == 0)
                 {
-                    g_deBridgeDebug = true;
+                    g_deBridgeDebugArg = true;
                 }
                 if (wcscmp(argv[i], L"--de-bridge-debug-ext") == 0)
                 {
-                    g_deBridgeDebugExt = true;
+                    g_deBridgeDebugExtArg = true;
+                }
+                if (wcscmp(argv[i], L"--de-bridge-ipc") == 0)
+                {
+                    g_deBridgeIpcArg = true;
+                }
+                if (wcscmp(argv[i], L"--de-bridge-probe") == 0)
+                {
+                    g_deBridgeProbeArg = true;
                 }
             }
             LocalFree(argv);
         }
 
+        std::filesystem::path configPath = GetPluginFilePath(CONFIG_FILE_NAME);
+        uint32_t configErrorCount;
+        uint32_t configFirstErrorLine;
+        [[maybe_unused]] bool isConfigLoaded = LoadConfigFile(configPath, configErrorCount, configFirstErrorLine);
+
+        g_appliedConfigGeneration = 0;
+        ResetSafePoint();
+
+        const BridgeConfig& config = GetConfig();
+        g_deBridgeDebug.store(g_deBridgeDebugArg || config.logLevel == LogLevel::Debug, std::memory_order_relaxed);
+        g_deBridgeDebugExt.store(g_deBridgeDebugExtArg || config.logLevel == LogLevel::DebugExt, std::memory_order_relaxed);
+
+        LOG_DEBUG("Config %s: %ls", isConfigLoaded ? "loaded" : "not found, using defaults", configPath.c_str());
+
         LOG_DEBUG("Debug mode: %s, Extended debug mode: %s",
-            g_deBridgeDebug ? LOG_MSG_ENABLED : LOG_MSG_DISABLED,
-            g_deBridgeDebugExt ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
+            g_deBridgeDebug.load(std::memory_order_relaxed) ? LOG_MSG_ENABLED : LOG_MSG_DISABLED,
+            g_deBridgeDebugExt.load(std::memory_order_relaxed) ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
 
-        if (!OnInitialize())
-        {
-            sdk->logger->Error(pluginHandle, "Failed to initialize. Plugin may not function correctly.");
-        }
+        OnInitialize();
+
+        LoadProfileStore(GetPluginFilePath(PROFILE_STORE_FILE_NAME));
+        g_profileSubscription = SubscribeModeChanges(&OnProfileModeChanged, nullptr);
+        SetModeSetCallback(&OnProfileModeSet, nullptr);
+
+        ApplyConfig();
+        StartConfigWatcher(configPath);
+
+        auto loadElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count();
+        sdk->logger->InfoF(pluginHandle, "Loaded in %.2f ms on the game's loading thread", loadElapsedUs / 1000.0);
         break;
     }
     case RED4ext::EMainReason::Unload:
     {
+        StopConfigWatcher();
+        StopControlChannel();
+        StopTransitionProbe();
+
+        UnsubscribeModeChanges(g_profileSubscription);
+        SetModeSetCallback(nullptr, nullptr);
+        g_profileSubscription = 0;
+        FlushProfiles(true);
+        ResetProfileStore();
+
         OnUninitialize();
+        ResetConfig();
         break;
     }
     }
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <filesystem>
 #include <RED4ext/RED4ext.hpp>
+#include "AllocAudit.h"
+#include "DLSSEnablerApi.h"
+#include "Log.h"
 
 // Function declarations
 void DLSSEnabler_GetVersionAsString(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::CString* aOut, int64_t a4);
@@ -11,108 +16,49 @@ void DLSSEnabler_SetFrameGenerationMode(RED4ext::IScriptable* aContext, RED4ext:
 void DLSSEnabler_SetFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4);
 void DLSSEnabler_SetDynamicFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4);
 void DLSSEnabler_ToggleFrameGenerationState(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4);
+void DLSSEnabler_RunBatch(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4);
+void DLSSEnabler_GetTransitionLatencyHistogram(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4);
+void DLSSEnabler_GetTransitionProbeStats(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, RED4ext::DynArray<int32_t>* aOut, int64_t a4);
+void DLSSEnabler_SetProfileSlot(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4);
+void DLSSEnabler_SetProfileContext(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, bool* aOut, int64_t a4);
+#ifdef DE_BRIDGE_ALLOC_AUDIT
+void DLSSEnabler_GetAllocationAuditViolations(RED4ext::IScriptable* aContext, RED4ext::CStackFrame* aFrame, int32_t* aOut, int64_t a4);
+#endif
 
-// Initialization and cleanup
-bool OnInitialize();
-void OnUninitialize();
+// Initialization and cleanup: dlss-enabler.dll is loaded on a background thread, off the game's loading thread
+enum class InitState : uint8_t
+{
+    Pending = 0,
+    Ready = 1,
+    Failed = 2,
+};
 
-// Utility functions
-bool IsGameReady();
-bool ShouldLog(const std::string& message);
+void OnInitialize();
+void OnUninitialize();
+bool InitializeDLSSEnabler();
 
-// DLSSEnabler's API
-typedef enum DLSS_ENABLER_FRAMEGENERATION_MODE
-{
-    DLSS_ENABLER_FRAMEGENERATION_DISABLED = 0,
-    DLSS_ENABLER_FRAMEGENERATION_ENABLED = 1,
-    DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED = 2,
-    DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED = 3,
-} DLSS_ENABLER_FRAMEGENERATION_MODE;
+// Game states
+bool OnRunningUpdate(RED4ext::CGameApplication* aApp);
 
-typedef enum DLSS_ENABLER_RESULT
-{
-    DLSS_ENABLER_RESULT_SUCCESS = 1,
-    DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED = 0,
-    DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT = -1,
-} DLSS_ENABLER_RESULT;
+// Config
+std::filesystem::path GetPluginFilePath(const wchar_t* fileName);
+void ApplyConfig();
+void UpdateControlChannel();
 
-typedef DLSS_ENABLER_RESULT(*GetFrameGenerationModeFunc)(DLSS_ENABLER_FRAMEGENERATION_MODE& mode);
-typedef DLSS_ENABLER_RESULT(*SetFrameGenerationModeFunc)(DLSS_ENABLER_FRAMEGENERATION_MODE mode);
+// Utility functions
+bool IsGameReady();
+bool ReadDLLVersion(uint16_t version[4]);
 
 // External declarations
 extern const RED4ext::Sdk* sdk;
 extern RED4ext::PluginHandle pluginHandle;
 extern HMODULE hDll;
-extern GetFrameGenerationModeFunc g_GetFrameGenerationModeFunc;
-extern SetFrameGenerationModeFunc g_SetFrameGenerationModeFunc;
-extern bool g_isLoggingDisabled;
-extern bool g_isLastMessageRepeated;
-extern bool g_deBridgeDebug;
-extern bool g_deBridgeDebugExt;
-
-// Logging macros
-#define FUNCTION_NAME __FUNCTION__
-
-#define LOG_DEBUG(format, ...) \
-    do { \
-        if (!g_isLoggingDisabled && (g_deBridgeDebug || g_deBridgeDebugExt)) { \
-            char buffer[256]; \
-            snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__); \
-            std::string message = std::string("[") + FUNCTION_NAME + "] " + buffer; \
-            if (ShouldLog(message)) { \
-                sdk->logger->InfoF(pluginHandle, "%s", message.c_str()); \
-            } \
-        } \
-    } while(0)
-
-#define LOG_DEBUG_EXT(format, ...) \
-    do { \
-        if (!g_isLoggingDisabled && g_deBridgeDebugExt) { \
-            char buffer[256]; \
-            snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__); \
-            std::string message = std::string("[") + FUNCTION_NAME + "] " + buffer; \
-            if (ShouldLog(message)) { \
-                sdk->logger->InfoF(pluginHandle, "%s", message.c_str()); \
-            } \
-        } \
-    } while(0)
-
-#define LOG_ERROR(format, ...) \
-    do { \
-        if (!g_isLoggingDisabled) { \
-            char buffer[256]; \
-            snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__); \
-            std::string message = std::string("[") + FUNCTION_NAME + "] " + buffer; \
-            if (ShouldLog(message)) { \
-                sdk->logger->ErrorF(pluginHandle, "%s", message.c_str()); \
-            } \
-        } \
-    } while(0)
-
-#define LOG_WARN(format, ...) \
-    do { \
-        if (!g_isLoggingDisabled && (g_deBridgeDebug || g_deBridgeDebugExt)) { \
-            char buffer[256]; \
-            snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__); \
-            std::string message = std::string("[") + FUNCTION_NAME + "] " + buffer; \
-            if (ShouldLog(message)) { \
-                sdk->logger->WarnF(pluginHandle, "%s", message.c_str()); \
-            } \
-        } \
-    } while(0)
+extern bool g_deBridgeDebugArg;
+extern bool g_deBridgeDebugExtArg;
+extern bool g_deBridgeIpcArg;
+extern bool g_deBridgeProbeArg;
+extern char g_dllVersionString[32];
+extern std::atomic<InitState> g_initState;
 
 // Constants
 extern const wchar_t* DLSS_ENABLER_DLL_NAME;
-extern const char* LOG_MSG_CALLED;
-extern const char* LOG_MSG_CALLED_SHOULD_ENABLE;
-extern const char* LOG_MSG_COMPLETED;
-extern const char* LOG_MSG_DISABLED;
-extern const char* LOG_MSG_ENABLED;
-extern const char* LOG_MSG_GAME_NOT_READY;
-extern const char* LOG_MSG_FALSE;
-extern const char* LOG_MSG_FUNC_ADDR_FAILED;
-extern const char* LOG_MSG_FUNC_GET_ADDR_FAILED;
-extern const char* LOG_MSG_FUNC_SET_ADDR_FAILED;
-extern const char* LOG_MSG_NULL_OUTPUT;
-extern const char* LOG_MSG_TRUE;
-extern const char* LOG_MSG_UNKNOWN;
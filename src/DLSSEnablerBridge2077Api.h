@@ -0,0 +1,87 @@
+#pragma once
+
+// Native interface of DLSS Enabler Bridge 2077 for other RED4ext plugins.
+// Copy this header to your project and resolve the function table at runtime:
+//
+//     HMODULE bridge = GetModuleHandleW(L"dlss-enabler-bridge-2077.dll");
+//     auto getApi = (DEBridge_GetApiFunc)GetProcAddress(bridge, DE_BRIDGE_GET_API_NAME);
+//     const DEBridge_Api* api = getApi ? getApi(DE_BRIDGE_API_VERSION) : nullptr;
+//
+// All functions can be called from any thread. Results follow DLSS Enabler's DLSS_ENABLER_RESULT (1 success, 0 unsupported, -1 bad argument).
+// See docs/native-api.md for details.
+
+#include <stdint.h>
+
+#define DE_BRIDGE_API_VERSION 1
+#define DE_BRIDGE_GET_API_NAME "DEBridge_GetApi"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct DEBridge_Snapshot
+{
+    uint32_t size;              // set by the caller to sizeof(DEBridge_Snapshot)
+    int32_t mode;               // last Frame Generation mode observed by the bridge, -1 if unknown
+    uint8_t isModeValid;
+    uint8_t readyState;         // 0 unknown, 1 paused or in the main menu, 2 ready
+    uint8_t isLoaded;           // dlss-enabler.dll is loaded and its API resolved
+    uint8_t reserved;
+    uint16_t version[4];        // dlss-enabler.dll file version, zeros if unknown
+    uint64_t changeCounter;     // incremented every time the bridge observes a mode change
+} DEBridge_Snapshot;
+
+// newMode and oldMode use GetFrameGenerationMode values, oldMode is -1 if it was unknown
+typedef void (*DEBridge_ModeChangedCallback)(int32_t newMode, int32_t oldMode, void* userData);
+
+typedef struct DEBridge_Api
+{
+    uint32_t size;
+    uint32_t version;
+
+    int32_t (*GetFrameGenerationMode)(int32_t* outMode);
+    int32_t (*SetFrameGenerationMode)(int32_t newMode);
+    int32_t (*GetSnapshot)(DEBridge_Snapshot* outSnapshot);
+
+    // Returns 0 if the subscriber table is full
+    uint32_t (*Subscribe)(DEBridge_ModeChangedCallback callback, void* userData);
+    void (*Unsubscribe)(uint32_t token);
+} DEBridge_Api;
+
+// Returns nullptr if requestedVersion is newer than the one implemented by the loaded bridge
+typedef const DEBridge_Api* (*DEBridge_GetApiFunc)(uint32_t requestedVersion);
+
+// Status page published to named shared memory for external tools (overlays etc.).
+// Written with a seqlock: retry while sequence is odd or changed between reading it before and after the payload.
+// See docs/native-api.md for details.
+
+#define DE_BRIDGE_STATUS_PAGE_NAME_WIN32 L"Local\\DLSSEnablerBridge2077.Status"
+#define DE_BRIDGE_STATUS_PAGE_NAME_POSIX "/dlss-enabler-bridge-2077.status"
+#define DE_BRIDGE_STATUS_PAGE_MAGIC 0x53424544u // "DEBS"
+#define DE_BRIDGE_STATUS_PAGE_LAYOUT 1
+
+typedef struct DEBridge_StatusPage
+{
+    uint32_t magic;
+    uint32_t layoutVersion;
+    uint32_t size;
+    uint32_t sequence;          // odd while the bridge is writing
+
+    int32_t mode;               // same as in DEBridge_Snapshot
+    uint8_t isModeValid;
+    uint8_t readyState;
+    uint8_t isLoaded;
+    uint8_t reserved;
+    uint16_t version[4];
+    uint64_t changeCounter;
+
+    // Telemetry summary: calls made into dlss-enabler.dll since the plugin was loaded
+    uint64_t getCalls;
+    uint64_t getFailures;
+    uint64_t setCalls;
+    uint64_t setFailures;
+} DEBridge_StatusPage;
+
+#ifdef __cplusplus
+}
+#endif
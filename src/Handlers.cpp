@@ -0,0 +1,186 @@
+#include "Handlers.h"
+#include "Log.h"
+#include "ModeCache.h"
+
+#ifdef DE_BRIDGE_HANDLERS_NAMESPACE
+namespace DE_BRIDGE_HANDLERS_NAMESPACE
+{
+#endif
+
+/////////////////////
+// Getters
+/////////////////////
+
+bool HandleGetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE& currentMode)
+{
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to get Frame Generation Mode. Result: %d", result);
+        return false;
+    }
+
+#ifndef DE_BRIDGE_PRODUCTION
+    if (g_deBridgeDebug.load(std::memory_order_relaxed))
+    {
+        const char* modeString;
+        switch (currentMode)
+        {
+        case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
+            modeString = "FG Disabled; DFG Disabled";
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+            modeString = "FG Enabled; DFG Disabled";
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
+            modeString = "FG Disabled; DFG Enabled";
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
+            modeString = "FG Enabled; DFG Enabled";
+            break;
+        default:
+            modeString = LOG_MSG_UNKNOWN;
+        }
+
+        LOG_DEBUG("Current Frame Generation Mode: %d", currentMode);
+        LOG_DEBUG("Current Frame Generation Status: %s", modeString);
+    }
+#endif
+
+    return true;
+}
+
+bool HandleGetFrameGenerationState(bool& isEnabled)
+{
+    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to get Frame Generation State. Result: %d", result);
+        return false;
+    }
+
+#ifndef DE_BRIDGE_PRODUCTION
+    if (g_deBridgeDebug.load(std::memory_order_relaxed))
+    {
+        const char* modeString;
+        switch (currentMode)
+        {
+        case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+            modeString = LOG_MSG_ENABLED;
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
+            modeString = LOG_MSG_DISABLED;
+            break;
+        default:
+            modeString = LOG_MSG_UNKNOWN;
+        }
+
+        LOG_DEBUG("Current Frame Generation State: %s", modeString);
+    }
+#endif
+
+    isEnabled = currentMode == DLSS_ENABLER_FRAMEGENERATION_ENABLED;
+    return true;
+}
+
+bool HandleGetDynamicFrameGenerationState(bool& isEnabled)
+{
+    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to get Dynamic Frame Generation State. Result: %d", result);
+        return false;
+    }
+
+#ifndef DE_BRIDGE_PRODUCTION
+    if (g_deBridgeDebug.load(std::memory_order_relaxed))
+    {
+        const char* modeString;
+        switch (currentMode)
+        {
+        case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
+            modeString = LOG_MSG_ENABLED;
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
+            modeString = LOG_MSG_ENABLED;
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+            modeString = LOG_MSG_DISABLED;
+            break;
+        case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
+            modeString = LOG_MSG_DISABLED;
+            break;
+        default:
+            modeString = LOG_MSG_UNKNOWN;
+        }
+
+        LOG_DEBUG("Current Dynamic Frame Generation State: %s", modeString);
+    }
+#endif
+
+    isEnabled = currentMode == DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED || currentMode == DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED;
+    return true;
+}
+
+/////////////////////
+// Setters
+/////////////////////
+
+bool HandleSetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE newMode)
+{
+    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
+
+    DLSS_ENABLER_RESULT result = ApplyFrameGenerationMode(newMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to set Frame Generation Mode. Result: %d", result);
+        return false;
+    }
+
+    LOG_DEBUG("Frame Generation mode set successfully: %d", newMode);
+    return true;
+}
+
+bool HandleSetFrameGenerationState(bool shouldEnable)
+{
+    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE newMode = shouldEnable ? DLSS_ENABLER_FRAMEGENERATION_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DISABLED;
+    DLSS_ENABLER_RESULT result = ApplyFrameGenerationMode(newMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to set Frame Generation. Result: %d", result);
+        return false;
+    }
+
+    LOG_DEBUG("Frame Generation set to %s", shouldEnable ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
+    return true;
+}
+
+bool HandleSetDynamicFrameGenerationState(bool shouldEnable)
+{
+    LOG_DEBUG_EXT("SetFrameGenerationMode function address obtained successfully");
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE newMode = shouldEnable ? DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED;
+    DLSS_ENABLER_RESULT result = ApplyFrameGenerationMode(newMode);
+
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        LOG_ERROR("Failed to set Dynamic Frame Generation. Result: %d", result);
+        return false;
+    }
+
+    LOG_DEBUG("Dynamic Frame Generation set to %s", shouldEnable ? LOG_MSG_ENABLED : LOG_MSG_DISABLED);
+    return true;
+}
+
+#ifdef DE_BRIDGE_HANDLERS_NAMESPACE
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include "DLSSEnablerApi.h"
+
+// Bodies of the getter and setter handlers, without RED4ext: the handlers read their parameters, check readiness
+// and DLSS Enabler's function addresses, then call these. Game thread only. Each returns false on failure, after
+// logging it.
+// The bench builds Handlers.cpp once per build variant, each with DE_BRIDGE_HANDLERS_NAMESPACE naming its own
+// namespace. The plugin leaves it undefined.
+
+#ifdef DE_BRIDGE_HANDLERS_NAMESPACE
+namespace DE_BRIDGE_HANDLERS_NAMESPACE
+{
+#endif
+
+bool HandleGetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE& currentMode);
+bool HandleGetFrameGenerationState(bool& isEnabled);
+bool HandleGetDynamicFrameGenerationState(bool& isEnabled);
+
+bool HandleSetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE newMode);
+bool HandleSetFrameGenerationState(bool shouldEnable);
+bool HandleSetDynamicFrameGenerationState(bool shouldEnable);
+
+#ifdef DE_BRIDGE_HANDLERS_NAMESPACE
+}
+#endif
@@ -0,0 +1,63 @@
+#include "Log.h"
+#include <cstring>
+#include <mutex>
+
+char g_lastLoggedMessage[LOG_MESSAGE_SIZE] = "";
+std::mutex g_lastLoggedMessageMutex;
+bool g_isLoggingDisabled = false;
+bool g_isLastMessageRepeated = false;
+std::atomic<bool> g_deBridgeDebug{ false };
+std::atomic<bool> g_deBridgeDebugExt{ false };
+
+// Constants
+const char* LOG_MSG_FUNC_ADDR_FAILED = "Failed to get function addresses. Error code: %lu";
+const char* LOG_MSG_FUNC_GET_ADDR_FAILED = "Failed to get GetFrameGenerationMode function address. Error code: %lu";
+const char* LOG_MSG_FUNC_SET_ADDR_FAILED = "Failed to get SetFrameGenerationMode function address. Error code: %lu";
+const char* LOG_MSG_UNKNOWN = "Unknown";
+#ifndef DE_BRIDGE_PRODUCTION
+const char* LOG_MSG_CALLED = "Called!";
+const char* LOG_MSG_CALLED_SHOULD_ENABLE = "Called with shouldEnable = %s";
+const char* LOG_MSG_COMPLETED = "Completed";
+const char* LOG_MSG_DISABLED = "Disabled";
+const char* LOG_MSG_ENABLED = "Enabled";
+const char* LOG_MSG_GAME_NOT_READY = "The game is paused, or in the main menu. Communication with DLSS Enabler is halted.";
+const char* LOG_MSG_INITIALIZING = "The plugin is still initializing. Communication with DLSS Enabler is halted.";
+const char* LOG_MSG_FALSE = "false";
+const char* LOG_MSG_NULL_OUTPUT = "Output parameter is null";
+const char* LOG_MSG_TRUE = "true";
+#endif
+
+////////////////////////
+// Restrict Logging: in case the modded Frame Generation goes *^(!$^% or methods are called excessively when FG is turned off in the game settings
+////////////////////////
+
+bool ShouldLog(const char* message)
+{
+    if (g_isLoggingDisabled) {
+        return false;
+    }
+
+    // The initialization thread logs too
+    std::lock_guard<std::mutex> lock(g_lastLoggedMessageMutex);
+
+    if (strcmp(message, g_lastLoggedMessage) == 0) {
+        if (!g_isLastMessageRepeated) {
+            g_isLastMessageRepeated = true;
+            return true;
+        }
+        return false;
+    }
+    else {
+        snprintf(g_lastLoggedMessage, sizeof(g_lastLoggedMessage), "%s", message);
+        g_isLastMessageRepeated = false;
+        return true;
+    }
+}
+
+void ResetLogState()
+{
+    std::lock_guard<std::mutex> lock(g_lastLoggedMessageMutex);
+    g_lastLoggedMessage[0] = '\0';
+    g_isLoggingDisabled = false;
+    g_isLastMessageRepeated = false;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// Logging macros: messages are formatted on the stack, logging doesn't allocate. Repeated messages are logged twice at most.
+// Messages go to WriteLog, defined by the binary (the plugin writes to the RED4ext log).
+//
+// Debug and warning messages depend on the runtime debug flags. The production build (DE_BRIDGE_PRODUCTION,
+// the Production configuration) compiles them out along with their arguments, so handlers check no flags and
+// the binary holds no debug strings. Errors are always logged.
+
+enum class LogSeverity : uint8_t
+{
+    Info = 0,
+    Warn = 1,
+    Error = 2,
+};
+
+void WriteLog(LogSeverity severity, const char* message);
+bool ShouldLog(const char* message);
+void ResetLogState();
+
+extern bool g_isLoggingDisabled;
+extern bool g_isLastMessageRepeated;
+// Written on the game thread when the config changes, read by every thread that logs
+extern std::atomic<bool> g_deBridgeDebug;
+extern std::atomic<bool> g_deBridgeDebugExt;
+
+#define FUNCTION_NAME __FUNCTION__
+#define LOG_MESSAGE_SIZE 320
+
+#define LOG_MESSAGE(severity, format, ...) \
+    do { \
+        char buffer[256]; \
+        snprintf(buffer, sizeof(buffer), format, ##__VA_ARGS__); \
+        char message[LOG_MESSAGE_SIZE]; \
+        snprintf(message, sizeof(message), "[%s] %s", FUNCTION_NAME, buffer); \
+        if (ShouldLog(message)) { \
+            WriteLog(severity, message); \
+        } \
+    } while(0)
+
+#ifndef DE_BRIDGE_PRODUCTION
+
+#define LOG_DEBUG(format, ...) \
+    do { \
+        if (!g_isLoggingDisabled && (g_deBridgeDebug.load(std::memory_order_relaxed) || g_deBridgeDebugExt.load(std::memory_order_relaxed))) { \
+            LOG_MESSAGE(LogSeverity::Info, format, ##__VA_ARGS__); \
+        } \
+    } while(0)
+
+#define LOG_DEBUG_EXT(format, ...) \
+    do { \
+        if (!g_isLoggingDisabled && g_deBridgeDebugExt.load(std::memory_order_relaxed)) { \
+            LOG_MESSAGE(LogSeverity::Info, format, ##__VA_ARGS__); \
+        } \
+    } while(0)
+
+#define LOG_WARN(format, ...) \
+    do { \
+        if (!g_isLoggingDisabled && (g_deBridgeDebug.load(std::memory_order_relaxed) || g_deBridgeDebugExt.load(std::memory_order_relaxed))) { \
+            LOG_MESSAGE(LogSeverity::Warn, format, ##__VA_ARGS__); \
+        } \
+    } while(0)
+
+#else
+
+#define LOG_DEBUG(format, ...) do {} while(0)
+#define LOG_DEBUG_EXT(format, ...) do {} while(0)
+#define LOG_WARN(format, ...) do {} while(0)
+
+#endif
+
+#define LOG_ERROR(format, ...) \
+    do { \
+        if (!g_isLoggingDisabled) { \
+            LOG_MESSAGE(LogSeverity::Error, format, ##__VA_ARGS__); \
+        } \
+    } while(0)
+
+// Messages shared by the handlers. The debug ones only exist in the instrumented build.
+extern const char* LOG_MSG_FUNC_ADDR_FAILED;
+extern const char* LOG_MSG_FUNC_GET_ADDR_FAILED;
+extern const char* LOG_MSG_FUNC_SET_ADDR_FAILED;
+extern const char* LOG_MSG_UNKNOWN;
+#ifndef DE_BRIDGE_PRODUCTION
+extern const char* LOG_MSG_CALLED;
+extern const char* LOG_MSG_CALLED_SHOULD_ENABLE;
+extern const char* LOG_MSG_COMPLETED;
+extern const char* LOG_MSG_DISABLED;
+extern const char* LOG_MSG_ENABLED;
+extern const char* LOG_MSG_GAME_NOT_READY;
+extern const char* LOG_MSG_INITIALIZING;
+extern const char* LOG_MSG_FALSE;
+extern const char* LOG_MSG_NULL_OUTPUT;
+extern const char* LOG_MSG_TRUE;
+#endif
@@ -0,0 +1,354 @@
+#include "ModeCache.h"
+#include "BridgeClock.h"
+#include "Config.h"
+#include "StatusPage.h"
+#include "TransitionProbe.h"
+#include <atomic>
+#include <mutex>
+
+struct ModeSubscriber
+{
+    uint32_t token;
+    ModeChangedCallback callback;
+    void* userData;
+};
+
+std::atomic<int32_t> g_cachedMode{ MODE_UNKNOWN };
+std::atomic<int64_t> g_cachedAtMs{ 0 };
+std::atomic<bool> g_isCacheValid{ false };
+std::atomic<uint64_t> g_modeChangeCounter{ 0 };
+std::atomic<uint8_t> g_readyState{ static_cast<uint8_t>(ReadyState::Unknown) };
+std::atomic<bool> g_isLoaded{ false };
+std::atomic<uint64_t> g_packedVersion{ 0 };
+
+// Telemetry
+std::atomic<uint64_t> g_getCalls{ 0 };
+std::atomic<uint64_t> g_getFailures{ 0 };
+std::atomic<uint64_t> g_setCalls{ 0 };
+std::atomic<uint64_t> g_setFailures{ 0 };
+
+std::mutex g_subscribersMutex;
+ModeSubscriber g_subscribers[MAX_MODE_SUBSCRIBERS] = {};
+uint32_t g_nextSubscriberToken = 1;
+ModeSetCallback g_modeSetCallback = nullptr;
+void* g_modeSetUserData = nullptr;
+
+// The mode the sets so far should result in. While a set is waiting to be read back, observations older than it
+// don't replace the prediction.
+std::mutex g_expectedModeMutex;
+int32_t g_expectedMode = MODE_UNKNOWN;
+bool g_isSetPending = false;
+int64_t g_setReadBackDueMs = 0;
+
+////////////////////////
+// Notify: fan a mode change out to the subscribers
+////////////////////////
+
+static void NotifyModeChanged(int32_t newMode, int32_t oldMode)
+{
+    ModeSubscriber subscribers[MAX_MODE_SUBSCRIBERS];
+    {
+        std::lock_guard<std::mutex> lock(g_subscribersMutex);
+        for (uint32_t i = 0; i < MAX_MODE_SUBSCRIBERS; ++i)
+        {
+            subscribers[i] = g_subscribers[i];
+        }
+    }
+
+    for (const ModeSubscriber& subscriber : subscribers)
+    {
+        if (subscriber.callback)
+        {
+            subscriber.callback(newMode, oldMode, subscriber.userData);
+        }
+    }
+}
+
+static void NotifyModeSet(int32_t expectedMode)
+{
+    ModeSetCallback callback;
+    void* userData;
+    {
+        std::lock_guard<std::mutex> lock(g_subscribersMutex);
+        callback = g_modeSetCallback;
+        userData = g_modeSetUserData;
+    }
+
+    if (callback)
+    {
+        callback(expectedMode, userData);
+    }
+}
+
+// The cached mode is the last one observed, it's only counted and fanned out when an observation differs from it.
+// A pending set ends when it's read back, or when it's SET_READ_BACK_TIMEOUT_MS old and assumed lost.
+static void RecordObservedMode(int32_t mode)
+{
+    int64_t now = GetBridgeClockMs();
+    g_cachedAtMs.store(now, std::memory_order_relaxed);
+    int32_t oldMode = g_cachedMode.exchange(mode, std::memory_order_acq_rel);
+    g_isCacheValid.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(g_expectedModeMutex);
+        if (!g_isSetPending || mode == g_expectedMode || now >= g_setReadBackDueMs)
+        {
+            g_expectedMode = mode;
+            g_isSetPending = false;
+        }
+    }
+    if (oldMode != mode)
+    {
+        g_modeChangeCounter.fetch_add(1, std::memory_order_release);
+        NotifyModeChanged(mode, oldMode);
+    }
+}
+
+/////////////////////
+// Lifecycle
+/////////////////////
+
+void ResetModeCache()
+{
+    g_cachedMode.store(MODE_UNKNOWN, std::memory_order_release);
+    g_isCacheValid.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(g_expectedModeMutex);
+        g_expectedMode = MODE_UNKNOWN;
+        g_isSetPending = false;
+    }
+    g_readyState.store(static_cast<uint8_t>(ReadyState::Unknown), std::memory_order_release);
+    g_isLoaded.store(false, std::memory_order_release);
+    g_packedVersion.store(0, std::memory_order_release);
+    g_getCalls.store(0, std::memory_order_relaxed);
+    g_getFailures.store(0, std::memory_order_relaxed);
+    g_setCalls.store(0, std::memory_order_relaxed);
+    g_setFailures.store(0, std::memory_order_relaxed);
+    PublishStatusPage();
+}
+
+void SetLoadedState(bool isLoaded, const uint16_t version[4])
+{
+    uint64_t packedVersion = 0;
+    if (version)
+    {
+        packedVersion = (static_cast<uint64_t>(version[0]) << 48) | (static_cast<uint64_t>(version[1]) << 32) |
+            (static_cast<uint64_t>(version[2]) << 16) | static_cast<uint64_t>(version[3]);
+    }
+
+    g_packedVersion.store(packedVersion, std::memory_order_release);
+    g_isLoaded.store(isLoaded, std::memory_order_release);
+    PublishStatusPage();
+}
+
+/////////////////////
+// DLSS Enabler calls
+/////////////////////
+
+DLSS_ENABLER_RESULT QueryFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE& mode, bool canUseCache)
+{
+    // The function pointers are written before the loaded state is published, they're never read before it
+    if (!g_isLoaded.load(std::memory_order_acquire))
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    GetFrameGenerationModeFunc getFunc = g_GetFrameGenerationModeFunc;
+    if (!getFunc)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    uint32_t cacheTtlMs = GetConfig().cacheTtlMs;
+    if (canUseCache && cacheTtlMs > 0)
+    {
+        int32_t cachedMode = g_cachedMode.load(std::memory_order_acquire);
+        if (g_isCacheValid.load(std::memory_order_acquire) && cachedMode != MODE_UNKNOWN && GetBridgeClockMs() - g_cachedAtMs.load(std::memory_order_relaxed) < cacheTtlMs)
+        {
+            mode = static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(cachedMode);
+            return DLSS_ENABLER_RESULT_SUCCESS;
+        }
+    }
+
+    DLSS_ENABLER_RESULT result = getFunc(mode);
+    g_getCalls.fetch_add(1, std::memory_order_relaxed);
+    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        RecordObservedMode(mode);
+    }
+    else
+    {
+        g_getFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PublishStatusPage();
+    return result;
+}
+
+DLSS_ENABLER_RESULT ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE mode)
+{
+    if (!g_isLoaded.load(std::memory_order_acquire))
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    SetFrameGenerationModeFunc setFunc = g_SetFrameGenerationModeFunc;
+    if (!setFunc)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    // Set modes only flip a single part of the state, so the cache is invalid until the next query reads the result back.
+    // The last observed mode is kept, the read-back only counts as a change if it differs.
+    DLSS_ENABLER_RESULT result = setFunc(mode);
+    g_setCalls.fetch_add(1, std::memory_order_relaxed);
+    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        g_isCacheValid.store(false, std::memory_order_release);
+        ProbeTransition(mode);
+
+        // Sets stack on each other until they're read back
+        int32_t expectedMode;
+        {
+            std::lock_guard<std::mutex> lock(g_expectedModeMutex);
+            g_expectedMode = PredictSetMode(g_expectedMode, mode);
+            g_isSetPending = true;
+            g_setReadBackDueMs = GetBridgeClockMs() + SET_READ_BACK_TIMEOUT_MS;
+            expectedMode = g_expectedMode;
+        }
+        NotifyModeSet(expectedMode);
+    }
+    else
+    {
+        g_setFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PublishStatusPage();
+    return result;
+}
+
+/////////////////////
+// Readiness
+/////////////////////
+
+void SetReadyState(bool isReady)
+{
+    uint8_t readyState = static_cast<uint8_t>(isReady ? ReadyState::Ready : ReadyState::NotReady);
+    if (g_readyState.exchange(readyState, std::memory_order_acq_rel) != readyState)
+    {
+        PublishStatusPage();
+    }
+}
+
+ReadyState GetReadyState()
+{
+    return static_cast<ReadyState>(g_readyState.load(std::memory_order_acquire));
+}
+
+/////////////////////
+// Snapshot
+/////////////////////
+
+ModeSnapshot GetModeSnapshot()
+{
+    ModeSnapshot snapshot = {};
+    snapshot.mode = g_cachedMode.load(std::memory_order_acquire);
+    snapshot.isModeValid = snapshot.mode != MODE_UNKNOWN;
+    snapshot.readyState = GetReadyState();
+    snapshot.isLoaded = g_isLoaded.load(std::memory_order_acquire);
+    snapshot.changeCounter = g_modeChangeCounter.load(std::memory_order_acquire);
+    snapshot.getCalls = g_getCalls.load(std::memory_order_relaxed);
+    snapshot.getFailures = g_getFailures.load(std::memory_order_relaxed);
+    snapshot.setCalls = g_setCalls.load(std::memory_order_relaxed);
+    snapshot.setFailures = g_setFailures.load(std::memory_order_relaxed);
+
+    uint64_t packedVersion = g_packedVersion.load(std::memory_order_acquire);
+    snapshot.version[0] = static_cast<uint16_t>(packedVersion >> 48);
+    snapshot.version[1] = static_cast<uint16_t>(packedVersion >> 32);
+    snapshot.version[2] = static_cast<uint16_t>(packedVersion >> 16);
+    snapshot.version[3] = static_cast<uint16_t>(packedVersion);
+
+    return snapshot;
+}
+
+/////////////////////
+// Subscribers
+/////////////////////
+
+uint32_t SubscribeModeChanges(ModeChangedCallback callback, void* userData)
+{
+    if (!callback)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_subscribersMutex);
+    for (ModeSubscriber& subscriber : g_subscribers)
+    {
+        if (!subscriber.callback)
+        {
+            subscriber.token = g_nextSubscriberToken++;
+            if (g_nextSubscriberToken == 0)
+            {
+                g_nextSubscriberToken = 1;
+            }
+            subscriber.callback = callback;
+            subscriber.userData = userData;
+            return subscriber.token;
+        }
+    }
+
+    return 0;
+}
+
+void UnsubscribeModeChanges(uint32_t token)
+{
+    if (token == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_subscribersMutex);
+    for (ModeSubscriber& subscriber : g_subscribers)
+    {
+        if (subscriber.token == token)
+        {
+            subscriber = {};
+            return;
+        }
+    }
+}
+
+void SetModeSetCallback(ModeSetCallback callback, void* userData)
+{
+    std::lock_guard<std::mutex> lock(g_subscribersMutex);
+    g_modeSetCallback = callback;
+    g_modeSetUserData = userData;
+}
+
+/////////////////////
+// Prediction: bit 0 of a mode is FG, bit 1 DFG
+/////////////////////
+
+int32_t PredictSetMode(int32_t mode, DLSS_ENABLER_FRAMEGENERATION_MODE setMode)
+{
+    if (setMode == DLSS_ENABLER_FRAMEGENERATION_DISABLED)
+    {
+        return 0;
+    }
+    if (mode < 0)
+    {
+        return MODE_UNKNOWN;
+    }
+
+    switch (setMode)
+    {
+    case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+        return mode | 1;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
+        return mode & ~2;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
+        return mode | 2;
+    default:
+        return MODE_UNKNOWN;
+    }
+}
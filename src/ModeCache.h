@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include "DLSSEnablerApi.h"
+
+// The Mode Cache is the bridge's single source of truth for the Frame Generation state.
+// Script handlers and the native API go through it, so every consumer sees the same mode, readiness and change counter.
+// It doesn't depend on RED4ext or Windows, all functions are safe to call from any thread.
+
+enum class ReadyState : uint8_t
+{
+    Unknown = 0,
+    NotReady = 1,
+    Ready = 2,
+};
+
+struct ModeSnapshot
+{
+    int32_t mode;
+    bool isModeValid;
+    ReadyState readyState;
+    bool isLoaded;
+    uint16_t version[4];
+    uint64_t changeCounter;
+    uint64_t getCalls;
+    uint64_t getFailures;
+    uint64_t setCalls;
+    uint64_t setFailures;
+};
+
+typedef void (*ModeChangedCallback)(int32_t newMode, int32_t oldMode, void* userData);
+typedef void (*ModeSetCallback)(int32_t expectedMode, void* userData);
+
+constexpr int32_t MODE_UNKNOWN = -1;
+constexpr uint32_t MAX_MODE_SUBSCRIBERS = 16;
+constexpr int64_t SET_READ_BACK_TIMEOUT_MS = 500; // until then, read-backs that don't match a set are taken as stale
+
+// Lifecycle
+void ResetModeCache();
+void SetLoadedState(bool isLoaded, const uint16_t version[4]);
+
+// Calls into dlss-enabler.dll and records the outcome. Queries are answered from the cache while it's younger than
+// the configured cache TTL, unless canUseCache is false.
+DLSS_ENABLER_RESULT QueryFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE& mode, bool canUseCache = true);
+DLSS_ENABLER_RESULT ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE mode);
+
+// Readiness as last checked on the game thread
+void SetReadyState(bool isReady);
+ReadyState GetReadyState();
+
+ModeSnapshot GetModeSnapshot();
+
+// Callbacks are invoked on the thread that observed the change, outside of any lock. Returns 0 when the table is full.
+uint32_t SubscribeModeChanges(ModeChangedCallback callback, void* userData);
+void UnsubscribeModeChanges(uint32_t token);
+
+// A single callback invoked after every successful set, with the mode the set is expected to result in.
+// Sets aren't observations: they don't count as changes, and the mode takes a while to become visible. Pass nullptr to remove it.
+void SetModeSetCallback(ModeSetCallback callback, void* userData);
+
+// The GetFrameGenerationMode value a set turns mode into, MODE_UNKNOWN if it depends on an unknown mode
+int32_t PredictSetMode(int32_t mode, DLSS_ENABLER_FRAMEGENERATION_MODE setMode);
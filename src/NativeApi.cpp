@@ -0,0 +1,109 @@
+#include "NativeApi.h"
+#include "AllocAudit.h"
+#include "ModeCache.h"
+
+////////////////////////
+// Native API: the same Mode Cache as the script functions, without the RTTI round trip
+////////////////////////
+
+static int32_t NativeApi_GetFrameGenerationMode(int32_t* outMode)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    if (!outMode)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT;
+    }
+
+    // Readiness can only be checked on the game thread, so rely on the last check made there
+    if (GetReadyState() != ReadyState::Ready)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode);
+    if (result == DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        *outMode = currentMode;
+    }
+
+    return result;
+}
+
+static int32_t NativeApi_SetFrameGenerationMode(int32_t newMode)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    if (newMode < 0 || newMode > 3)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT;
+    }
+
+    if (GetReadyState() != ReadyState::Ready)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    return ApplyFrameGenerationMode(static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(newMode));
+}
+
+static int32_t NativeApi_GetSnapshot(DEBridge_Snapshot* outSnapshot)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    if (!outSnapshot || outSnapshot->size < sizeof(DEBridge_Snapshot))
+    {
+        return DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT;
+    }
+
+    ModeSnapshot snapshot = GetModeSnapshot();
+
+    outSnapshot->mode = snapshot.mode;
+    outSnapshot->isModeValid = snapshot.isModeValid;
+    outSnapshot->readyState = static_cast<uint8_t>(snapshot.readyState);
+    outSnapshot->isLoaded = snapshot.isLoaded;
+    outSnapshot->reserved = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        outSnapshot->version[i] = snapshot.version[i];
+    }
+    outSnapshot->changeCounter = snapshot.changeCounter;
+
+    return DLSS_ENABLER_RESULT_SUCCESS;
+}
+
+static uint32_t NativeApi_Subscribe(DEBridge_ModeChangedCallback callback, void* userData)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    return SubscribeModeChanges(callback, userData);
+}
+
+static void NativeApi_Unsubscribe(uint32_t token)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    UnsubscribeModeChanges(token);
+}
+
+static const DEBridge_Api g_nativeApi =
+{
+    sizeof(DEBridge_Api),
+    DE_BRIDGE_API_VERSION,
+    &NativeApi_GetFrameGenerationMode,
+    &NativeApi_SetFrameGenerationMode,
+    &NativeApi_GetSnapshot,
+    &NativeApi_Subscribe,
+    &NativeApi_Unsubscribe,
+};
+
+const DEBridge_Api* GetNativeApi(uint32_t requestedVersion)
+{
+    if (requestedVersion == 0 || requestedVersion > DE_BRIDGE_API_VERSION)
+    {
+        return nullptr;
+    }
+
+    return &g_nativeApi;
+}
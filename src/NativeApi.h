@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include "DLSSEnablerBridge2077Api.h"
+
+// The native API's function table, exported by the plugin as DEBridge_GetApi.
+// It doesn't depend on RED4ext or Windows, so the Linux test builds call it directly.
+
+// Returns nullptr if requestedVersion is 0 or newer than DE_BRIDGE_API_VERSION
+const DEBridge_Api* GetNativeApi(uint32_t requestedVersion);
@@ -0,0 +1,385 @@
+#include "ProfileStore.h"
+#include "BridgeClock.h"
+#include "Config.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+
+struct ProfileFileHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+};
+
+struct ProfileRecord
+{
+    uint64_t slotHash;
+    uint32_t lastUsed;
+    uint8_t context;
+    uint8_t mode;
+    uint8_t reserved[2];
+};
+
+static_assert(sizeof(ProfileFileHeader) == 8, "The profile file header is written as is");
+static_assert(sizeof(ProfileRecord) == 16, "Profile records are written as is");
+
+std::mutex g_profileMutex;
+ProfileRecord g_profiles[PROFILE_STORE_CAPACITY] = {};
+uint32_t g_profileCount = 0;
+uint32_t g_profileClock = 0;
+uint64_t g_profileSlotHash = 0;
+GameContext g_profileContext = GameContext::None;
+std::atomic<bool> g_isProfileDirty{ false };
+std::atomic<bool> g_isProfileApplyPending{ false };
+int32_t g_profileAwaitedMode = -1;
+int64_t g_profileAwaitDeadlineMs = 0;
+std::filesystem::path g_profileStorePath;
+
+////////////////////////
+// Keys: slot names are hashed (FNV-1a), so records have a fixed size
+////////////////////////
+
+static uint64_t HashProfileSlot(std::string_view slotName)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : slotName)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+
+    // 0 means no slot
+    return hash != 0 ? hash : 1;
+}
+
+static ProfileRecord* FindProfileLocked(uint64_t slotHash, GameContext context)
+{
+    for (uint32_t i = 0; i < g_profileCount; ++i)
+    {
+        if (g_profiles[i].slotHash == slotHash && g_profiles[i].context == static_cast<uint8_t>(context))
+        {
+            return &g_profiles[i];
+        }
+    }
+
+    return nullptr;
+}
+
+static ProfileRecord* AddProfileLocked(uint64_t slotHash, GameContext context)
+{
+    ProfileRecord* record;
+    if (g_profileCount < PROFILE_STORE_CAPACITY)
+    {
+        record = &g_profiles[g_profileCount++];
+    }
+    else
+    {
+        record = &g_profiles[0];
+        for (ProfileRecord& candidate : g_profiles)
+        {
+            if (candidate.lastUsed < record->lastUsed)
+            {
+                record = &candidate;
+            }
+        }
+    }
+
+    *record = {};
+    record->slotHash = slotHash;
+    record->context = static_cast<uint8_t>(context);
+    return record;
+}
+
+/////////////////////
+// File
+/////////////////////
+
+bool LoadProfileStore(const std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    g_profileStorePath = path;
+    g_profileCount = 0;
+    g_profileClock = 0;
+    g_isProfileDirty.store(false, std::memory_order_relaxed);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    ProfileFileHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != PROFILE_STORE_MAGIC || header.version != PROFILE_STORE_VERSION || header.count > PROFILE_STORE_CAPACITY)
+    {
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(g_profiles), header.count * sizeof(ProfileRecord));
+    if (!file)
+    {
+        return false;
+    }
+
+    // Drop anything a newer or damaged file could hold, a bad record must never reach DLSS Enabler
+    for (uint32_t i = 0; i < header.count; ++i)
+    {
+        const ProfileRecord& record = g_profiles[i];
+        if (record.slotHash == 0 || record.context >= GAME_CONTEXT_COUNT || record.mode > 3)
+        {
+            continue;
+        }
+
+        g_profiles[g_profileCount++] = record;
+        if (record.lastUsed > g_profileClock)
+        {
+            g_profileClock = record.lastUsed;
+        }
+    }
+
+    return true;
+}
+
+bool FlushProfileStore()
+{
+    static ProfileRecord records[PROFILE_STORE_CAPACITY];
+
+    if (!g_isProfileDirty.exchange(false, std::memory_order_acq_rel))
+    {
+        return true;
+    }
+
+    // Copied out, so recording from other threads isn't blocked by the file
+    ProfileFileHeader header = { PROFILE_STORE_MAGIC, PROFILE_STORE_VERSION, 0 };
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(g_profileMutex);
+        header.count = static_cast<uint16_t>(g_profileCount);
+        for (uint32_t i = 0; i < g_profileCount; ++i)
+        {
+            records[i] = g_profiles[i];
+        }
+        path = g_profileStorePath;
+    }
+
+    if (path.empty())
+    {
+        return false;
+    }
+
+    // Written next to the store and renamed over it, a crash never leaves a half-written file
+    std::filesystem::path tempPath = path;
+    tempPath += L".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records), header.count * sizeof(ProfileRecord));
+        if (!file)
+        {
+            g_isProfileDirty.store(true, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        g_isProfileDirty.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void ResetProfileStore()
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    g_profileCount = 0;
+    g_profileClock = 0;
+    g_profileSlotHash = 0;
+    g_profileContext = GameContext::None;
+    g_profileStorePath.clear();
+    g_isProfileDirty.store(false, std::memory_order_relaxed);
+    g_isProfileApplyPending.store(false, std::memory_order_relaxed);
+    g_profileAwaitedMode = -1;
+}
+
+bool IsProfileStoreDirty()
+{
+    return g_isProfileDirty.load(std::memory_order_relaxed);
+}
+
+/////////////////////
+// Key
+/////////////////////
+
+void SetProfileSlot(std::string_view slotName)
+{
+    uint64_t slotHash = slotName.empty() ? 0 : HashProfileSlot(slotName);
+
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    if (slotHash != g_profileSlotHash)
+    {
+        g_profileSlotHash = slotHash;
+        g_isProfileApplyPending.store(slotHash != 0, std::memory_order_release);
+    }
+}
+
+void SetProfileContext(GameContext context)
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    if (context != g_profileContext)
+    {
+        g_profileContext = context;
+        g_isProfileApplyPending.store(g_profileSlotHash != 0, std::memory_order_release);
+    }
+}
+
+void RequestProfileApply()
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    g_isProfileApplyPending.store(g_profileSlotHash != 0, std::memory_order_release);
+}
+
+bool IsProfileApplyPending()
+{
+    return g_isProfileApplyPending.load(std::memory_order_acquire);
+}
+
+void MarkProfileApplied(int32_t appliedMode)
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    g_profileAwaitedMode = appliedMode;
+    g_profileAwaitDeadlineMs = GetBridgeClockMs() + GetConfig().probeTimeoutMs;
+    g_isProfileApplyPending.store(false, std::memory_order_release);
+}
+
+/////////////////////
+// Modes
+/////////////////////
+
+bool FindProfileMode(int32_t& mode)
+{
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    if (g_profileSlotHash == 0)
+    {
+        return false;
+    }
+
+    ProfileRecord* record = FindProfileLocked(g_profileSlotHash, g_profileContext);
+    if (!record && g_profileContext != GameContext::None)
+    {
+        record = FindProfileLocked(g_profileSlotHash, GameContext::None);
+    }
+    if (!record)
+    {
+        return false;
+    }
+
+    // Only kept in memory until the next flush, recency alone isn't worth a write
+    record->lastUsed = ++g_profileClock;
+    mode = record->mode;
+    return true;
+}
+
+// Stores the mode for the current key, keeping contexts without a mode of their own on the slot's record
+static void StoreProfileModeLocked(int32_t mode)
+{
+    ProfileRecord* record = FindProfileLocked(g_profileSlotHash, g_profileContext);
+    if (!record && g_profileContext != GameContext::None)
+    {
+        // A context only gets its own record once it differs from the slot's mode
+        ProfileRecord* slotRecord = FindProfileLocked(g_profileSlotHash, GameContext::None);
+        if (slotRecord && slotRecord->mode == mode)
+        {
+            return;
+        }
+    }
+
+    if (record && record->mode == mode)
+    {
+        return;
+    }
+
+    if (!record)
+    {
+        record = AddProfileLocked(g_profileSlotHash, g_profileContext);
+    }
+
+    record->mode = static_cast<uint8_t>(mode);
+    record->lastUsed = ++g_profileClock;
+    g_isProfileDirty.store(true, std::memory_order_relaxed);
+}
+
+void RecordProfileMode(int32_t mode)
+{
+    if (mode < 0 || mode > 3 || g_isProfileApplyPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    if (g_profileSlotHash == 0)
+    {
+        return;
+    }
+
+    if (g_profileAwaitedMode >= 0)
+    {
+        if (mode != g_profileAwaitedMode && GetBridgeClockMs() < g_profileAwaitDeadlineMs)
+        {
+            return;
+        }
+        g_profileAwaitedMode = -1;
+    }
+
+    StoreProfileModeLocked(mode);
+}
+
+void RecordProfileSetMode(int32_t expectedMode)
+{
+    // The profile's own sets are followed by MarkProfileApplied
+    if (expectedMode < 0 || expectedMode > 3 || g_isProfileApplyPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_profileMutex);
+    if (g_profileSlotHash == 0)
+    {
+        return;
+    }
+
+    g_profileAwaitedMode = expectedMode;
+    g_profileAwaitDeadlineMs = GetBridgeClockMs() + GetConfig().probeTimeoutMs;
+    StoreProfileModeLocked(expectedMode);
+}
+
+uint32_t GetProfileSetModes(int32_t observedMode, int32_t storedMode, DLSS_ENABLER_FRAMEGENERATION_MODE setModes[MAX_PRESET_MODES])
+{
+    uint32_t count = 0;
+
+    // Bit 0 is FG, bit 1 DFG. Disabling FG disables DFG as well, so it goes first.
+    if ((storedMode & 1) != (observedMode & 1))
+    {
+        if (storedMode & 1)
+        {
+            setModes[count++] = DLSS_ENABLER_FRAMEGENERATION_ENABLED;
+            observedMode |= 1;
+        }
+        else
+        {
+            setModes[count++] = DLSS_ENABLER_FRAMEGENERATION_DISABLED;
+            observedMode = 0;
+        }
+    }
+
+    if ((storedMode & 2) != (observedMode & 2))
+    {
+        setModes[count++] = (storedMode & 2) ? DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED : DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED;
+    }
+
+    return count;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include "CommandQueue.h"
+
+// The Profile Store remembers the Frame Generation mode per save slot and, optionally, per game context reported from script.
+// Records live in a fixed table, changes only mark it dirty and are written to the file in batches by FlushProfileStore.
+// All functions except the file ones are safe to call from any thread.
+
+#define PROFILE_STORE_FILE_NAME L"dlss-enabler-bridge-2077.profiles"
+
+constexpr uint32_t PROFILE_STORE_CAPACITY = 256;  // the least recently used record is replaced when full
+constexpr uint32_t PROFILE_STORE_MAGIC = 0x50424544u;  // "DEBP"
+constexpr uint16_t PROFILE_STORE_VERSION = 1;
+
+enum class GameContext : uint8_t
+{
+    None = 0,       // the slot's own mode, used when a context has none stored
+    Combat = 1,
+    Driving = 2,
+    Cutscene = 3,
+};
+
+constexpr uint32_t GAME_CONTEXT_COUNT = 4;
+
+// File, game thread only. Loading a missing file starts an empty store.
+bool LoadProfileStore(const std::filesystem::path& path);
+bool FlushProfileStore();
+void ResetProfileStore();
+bool IsProfileStoreDirty();
+
+// The key changing requests an apply, so does a new game session
+void SetProfileSlot(std::string_view slotName);
+void SetProfileContext(GameContext context);
+void RequestProfileApply();
+bool IsProfileApplyPending();
+
+// A set takes a while to become visible, until then (or the configured probe timeout) observed modes are stale and not recorded.
+// Pass -1 when no set was made.
+void MarkProfileApplied(int32_t appliedMode);
+
+// Mode stored for the current slot and context, falling back to the slot's None context
+bool FindProfileMode(int32_t& mode);
+
+// Records an observed mode for the current key. Ignored until the stored mode was applied, so it's never overwritten by the mode a session starts with.
+void RecordProfileMode(int32_t mode);
+
+// Records the mode a set is expected to result in, so sets are stored even if nothing reads the mode back.
+// Until it's visible (or the configured probe timeout), observed modes are stale and not recorded.
+void RecordProfileSetMode(int32_t expectedMode);
+
+// Set modes changing only the parts of observedMode that differ from storedMode (GetFrameGenerationMode values). Returns their count.
+uint32_t GetProfileSetModes(int32_t observedMode, int32_t storedMode, DLSS_ENABLER_FRAMEGENERATION_MODE setModes[MAX_PRESET_MODES]);
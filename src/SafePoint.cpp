@@ -0,0 +1,182 @@
+#include "SafePoint.h"
+#include "BridgeClock.h"
+#include "CommandQueue.h"
+#include "Config.h"
+#include "Log.h"
+#include "ModeCache.h"
+#include "ProfileStore.h"
+
+bool g_isSessionStarted = false;
+int64_t g_nextSessionCheckMs = 0;
+int64_t g_profileFlushDueMs = 0;
+bool g_isProfileFlushDue = false;
+
+////////////////////////
+// Profiles: the mode stored for the save slot and context is applied with the sets that differ, changes are written in batches
+////////////////////////
+
+static void ApplyProfile()
+{
+    int32_t storedMode;
+    if (!FindProfileMode(storedMode))
+    {
+        MarkProfileApplied(-1);
+        return;
+    }
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+    DLSS_ENABLER_RESULT result = QueryFrameGenerationMode(currentMode, false);
+    if (result != DLSS_ENABLER_RESULT_SUCCESS)
+    {
+        // Frame Generation is off in the game settings, the profile is tried again on the next session or key change
+        LOG_WARN("Failed to read the mode for the stored profile. Result: %d", result);
+        MarkProfileApplied(-1);
+        return;
+    }
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE setModes[MAX_PRESET_MODES];
+    uint32_t setCount = GetProfileSetModes(currentMode, storedMode, setModes);
+    for (uint32_t i = 0; i < setCount; ++i)
+    {
+        result = ApplyFrameGenerationMode(setModes[i]);
+        if (result != DLSS_ENABLER_RESULT_SUCCESS)
+        {
+            LOG_ERROR("Failed to apply the stored profile. Result: %d", result);
+            MarkProfileApplied(-1);
+            return;
+        }
+    }
+
+    LOG_DEBUG("Stored profile applied. Mode: %d -> %d with %u set(s)", currentMode, storedMode, setCount);
+    MarkProfileApplied(setCount > 0 ? storedMode : -1);
+}
+
+void FlushProfiles(bool isForced)
+{
+    if (!IsProfileStoreDirty())
+    {
+        return;
+    }
+
+    int64_t now = GetBridgeClockMs();
+    if (!g_isProfileFlushDue)
+    {
+        g_profileFlushDueMs = now + PROFILE_FLUSH_INTERVAL_MS;
+        g_isProfileFlushDue = true;
+    }
+
+    if (!isForced && g_isSessionStarted && now < g_profileFlushDueMs)
+    {
+        return;
+    }
+    g_isProfileFlushDue = false;
+
+    if (!FlushProfileStore())
+    {
+        LOG_ERROR("Failed to write the profile store");
+    }
+}
+
+/////////////////////
+// Session
+/////////////////////
+
+static void StartSession()
+{
+    g_isSessionStarted = true;
+
+    // A stored profile wins over the default preset
+    int32_t storedMode;
+    if (GetConfig().isProfileStoreEnabled && FindProfileMode(storedMode))
+    {
+        RequestProfileApply();
+        return;
+    }
+
+    const ModePreset* preset = FindPreset(GetConfig().defaultPreset);
+    if (preset && QueuePreset(*preset))
+    {
+        LOG_DEBUG("Default preset queued: %s", preset->name);
+    }
+}
+
+void ResetSafePoint()
+{
+    g_isSessionStarted = false;
+    g_nextSessionCheckMs = 0;
+    g_isProfileFlushDue = false;
+}
+
+void ReportGameReadiness(GameReadiness readiness)
+{
+    if (readiness == GameReadiness::Initializing)
+    {
+        return;
+    }
+
+    SetReadyState(readiness == GameReadiness::Ready);
+
+    if (readiness == GameReadiness::MainMenu && g_isSessionStarted)
+    {
+        g_isSessionStarted = false;
+        LOG_DEBUG("Game session ended");
+    }
+}
+
+bool IsSessionStarted()
+{
+    return g_isSessionStarted;
+}
+
+////////////////////////
+// Safe Point: mode changes queued off the game thread are applied here, once per frame at most
+////////////////////////
+
+void RunSafePoint(GameReadinessCheck checkReadiness)
+{
+    FlushProfiles(false);
+
+    bool isProfilePending = IsProfileApplyPending() && GetConfig().isProfileStoreEnabled;
+    bool hasQueuedCommands = GetQueuedCommandCount() > 0;
+
+    // Readiness checks can be expensive (RTTI in the plugin), so without pending work it's only checked a few times
+    // per second: to start a session, or to notice the return to the main menu that ends it
+    int64_t now = GetBridgeClockMs();
+    if (!hasQueuedCommands && !isProfilePending && now < g_nextSessionCheckMs)
+    {
+        return;
+    }
+    g_nextSessionCheckMs = now + SESSION_CHECK_INTERVAL_MS;
+
+    GameReadiness readiness = checkReadiness();
+    ReportGameReadiness(readiness);
+    if (readiness != GameReadiness::Ready)
+    {
+        return;
+    }
+
+    if (!g_isSessionStarted)
+    {
+        StartSession();
+    }
+
+    if (IsProfileApplyPending() && GetConfig().isProfileStoreEnabled)
+    {
+        ApplyProfile();
+    }
+
+    if (GetQueuedCommandCount() == 0)
+    {
+        return;
+    }
+
+    uint32_t failed = DrainCommandQueue();
+    if (failed > 0)
+    {
+        LOG_ERROR("Failed to apply %u queued Frame Generation mode change(s)", failed);
+    }
+    else
+    {
+        LOG_DEBUG("Queued Frame Generation mode changes applied");
+    }
+}
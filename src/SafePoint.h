@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// The Safe Point is the game thread's update, once per frame: it follows the game session, applies the stored profile
+// or the default preset when a session starts, drains the Command Queue and writes profile changes in batches.
+// Readiness is checked by the caller (through RTTI in the plugin, from events in the simulator), only when there's
+// work or a session check is due. Game thread only, it doesn't depend on RED4ext or Windows.
+
+constexpr int64_t SESSION_CHECK_INTERVAL_MS = 500;
+constexpr int64_t PROFILE_FLUSH_INTERVAL_MS = 30000;
+
+enum class GameReadiness : uint8_t
+{
+    Ready = 0,
+    Paused = 1,         // or otherwise not ready, the session goes on
+    MainMenu = 2,       // ends the session
+    Initializing = 3,   // the plugin isn't initialized yet, the game's readiness is unknown
+};
+
+typedef GameReadiness (*GameReadinessCheck)();
+
+void ResetSafePoint();
+
+// Every readiness check reports here, wherever it's made: it's published to the Mode Cache, and the main menu ends the session
+void ReportGameReadiness(GameReadiness readiness);
+bool IsSessionStarted();
+
+void RunSafePoint(GameReadinessCheck checkReadiness);
+
+// Changes are written once they're PROFILE_FLUSH_INTERVAL_MS old, when a session ends or when forced
+void FlushProfiles(bool isForced);
@@ -0,0 +1,157 @@
+#include "StatusPage.h"
+#include "DLSSEnablerBridge2077Api.h"
+#include "ModeCache.h"
+#include <atomic>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+HANDLE g_statusPageMapping = nullptr;
+#else
+int g_statusPageFd = -1;
+#endif
+std::atomic<DEBridge_StatusPage*> g_statusPage{ nullptr };
+
+// Writers from different threads are serialized, readers never take it
+std::mutex g_statusPageWriteMutex;
+
+template <typename T>
+static void StoreRelaxed(T& field, T value)
+{
+    std::atomic_ref<T>(field).store(value, std::memory_order_relaxed);
+}
+
+/////////////////////
+// Open / Close
+/////////////////////
+
+bool OpenStatusPage()
+{
+    if (g_statusPage.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    void* view = nullptr;
+
+#ifdef _WIN32
+    g_statusPageMapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(DEBridge_StatusPage), DE_BRIDGE_STATUS_PAGE_NAME_WIN32);
+    if (!g_statusPageMapping)
+    {
+        return false;
+    }
+
+    view = MapViewOfFile(g_statusPageMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(DEBridge_StatusPage));
+    if (!view)
+    {
+        CloseHandle(g_statusPageMapping);
+        g_statusPageMapping = nullptr;
+        return false;
+    }
+#else
+    g_statusPageFd = shm_open(DE_BRIDGE_STATUS_PAGE_NAME_POSIX, O_CREAT | O_RDWR, 0644);
+    if (g_statusPageFd < 0)
+    {
+        return false;
+    }
+
+    if (ftruncate(g_statusPageFd, sizeof(DEBridge_StatusPage)) != 0)
+    {
+        close(g_statusPageFd);
+        g_statusPageFd = -1;
+        return false;
+    }
+
+    view = mmap(nullptr, sizeof(DEBridge_StatusPage), PROT_READ | PROT_WRITE, MAP_SHARED, g_statusPageFd, 0);
+    if (view == MAP_FAILED)
+    {
+        close(g_statusPageFd);
+        g_statusPageFd = -1;
+        return false;
+    }
+#endif
+
+    DEBridge_StatusPage* page = static_cast<DEBridge_StatusPage*>(view);
+    StoreRelaxed(page->sequence, 0u);
+    page->magic = DE_BRIDGE_STATUS_PAGE_MAGIC;
+    page->layoutVersion = DE_BRIDGE_STATUS_PAGE_LAYOUT;
+    page->size = sizeof(DEBridge_StatusPage);
+
+    g_statusPage.store(page, std::memory_order_release);
+    PublishStatusPage();
+    return true;
+}
+
+void CloseStatusPage()
+{
+    std::lock_guard<std::mutex> lock(g_statusPageWriteMutex);
+
+    DEBridge_StatusPage* page = g_statusPage.exchange(nullptr, std::memory_order_acq_rel);
+    if (!page)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(page);
+    CloseHandle(g_statusPageMapping);
+    g_statusPageMapping = nullptr;
+#else
+    munmap(page, sizeof(DEBridge_StatusPage));
+    close(g_statusPageFd);
+    g_statusPageFd = -1;
+    shm_unlink(DE_BRIDGE_STATUS_PAGE_NAME_POSIX);
+#endif
+}
+
+/////////////////////
+// Publish
+/////////////////////
+
+void PublishStatusPage()
+{
+    if (!g_statusPage.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_statusPageWriteMutex);
+
+    DEBridge_StatusPage* page = g_statusPage.load(std::memory_order_acquire);
+    if (!page)
+    {
+        return;
+    }
+
+    // Taken under the lock, so a writer holding an older snapshot can't publish after a newer one
+    ModeSnapshot snapshot = GetModeSnapshot();
+
+    std::atomic_ref<uint32_t> sequence(page->sequence);
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    StoreRelaxed(page->mode, snapshot.mode);
+    StoreRelaxed(page->isModeValid, static_cast<uint8_t>(snapshot.isModeValid));
+    StoreRelaxed(page->readyState, static_cast<uint8_t>(snapshot.readyState));
+    StoreRelaxed(page->isLoaded, static_cast<uint8_t>(snapshot.isLoaded));
+    for (int i = 0; i < 4; ++i)
+    {
+        StoreRelaxed(page->version[i], snapshot.version[i]);
+    }
+    StoreRelaxed(page->changeCounter, snapshot.changeCounter);
+    StoreRelaxed(page->getCalls, snapshot.getCalls);
+    StoreRelaxed(page->getFailures, snapshot.getFailures);
+    StoreRelaxed(page->setCalls, snapshot.setCalls);
+    StoreRelaxed(page->setFailures, snapshot.setFailures);
+
+    sequence.store(current + 2, std::memory_order_release);
+}
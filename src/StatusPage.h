@@ -0,0 +1,11 @@
+#pragma once
+
+// The Status Page mirrors the Mode Cache to named shared memory, so external tools can read it without calling into the game.
+// Windows uses a named file mapping, other platforms a POSIX shm object (used by the Linux test builds).
+
+// Returns false if the shared memory couldn't be created, publishing becomes a no-op then
+bool OpenStatusPage();
+void CloseStatusPage();
+
+// Copies the current Mode Cache snapshot to the page. Safe to call from any thread, never blocks readers.
+void PublishStatusPage();
@@ -0,0 +1,275 @@
+#include "TransitionProbe.h"
+#include "Config.h"
+#include "ModeCache.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using ProbeClock = std::chrono::steady_clock;
+
+struct PendingProbe
+{
+    bool isPending;
+    DLSS_ENABLER_FRAMEGENERATION_MODE setMode;
+    ProbeClock::time_point start;
+};
+
+std::thread g_probeThread;
+std::atomic<bool> g_isProbeRunning{ false };
+std::mutex g_probeMutex;
+std::condition_variable g_probeCondition;
+PendingProbe g_pendingProbe = {};
+bool g_isProbeStopping = false;
+std::atomic<uint64_t> g_probeGeneration{ 0 };
+
+std::atomic<uint32_t> g_transitionHistogram[TRANSITION_HISTOGRAM_BUCKETS] = {};
+std::atomic<uint32_t> g_transitionSamples{ 0 };
+std::atomic<uint32_t> g_transitionReverted{ 0 };
+std::atomic<uint32_t> g_transitionTimedOut{ 0 };
+std::atomic<uint32_t> g_transitionSuperseded{ 0 };
+std::atomic<uint32_t> g_lastTransitionLatencyUs{ 0 };
+
+////////////////////////
+// Mode Matching: set modes flip one part of the state, GetFrameGenerationMode reports both (bit 0 FG, bit 1 DFG)
+////////////////////////
+
+bool IsModeApplied(DLSS_ENABLER_FRAMEGENERATION_MODE setMode, int32_t observedMode)
+{
+    if (observedMode < 0)
+    {
+        return false;
+    }
+
+    bool isFGEnabled = (observedMode & 1) != 0;
+    bool isDFGEnabled = (observedMode & 2) != 0;
+
+    switch (setMode)
+    {
+    case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
+        return !isFGEnabled && !isDFGEnabled;
+    case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+        return isFGEnabled;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
+        return !isDFGEnabled;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
+        return isDFGEnabled;
+    default:
+        return false;
+    }
+}
+
+/////////////////////
+// Recording
+/////////////////////
+
+static void RecordLatency(uint32_t latencyUs)
+{
+    uint32_t bucket = 0;
+    while (bucket < TRANSITION_HISTOGRAM_BUCKETS - 1 && latencyUs >= (TRANSITION_HISTOGRAM_FIRST_BOUND_US << bucket))
+    {
+        ++bucket;
+    }
+
+    g_transitionHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    g_lastTransitionLatencyUs.store(latencyUs, std::memory_order_relaxed);
+    g_transitionSamples.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A probe interrupted by Stop isn't counted
+static void CountSuperseded()
+{
+    if (g_isProbeRunning.load(std::memory_order_acquire))
+    {
+        g_transitionSuperseded.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Reads the mode back until it matches (or stops matching, when isHolding) or the deadline passes.
+// Returns 1 if the condition was reached, 0 on deadline, -1 if the probe was superseded or stopped, -2 once the game
+// isn't ready: dlss-enabler.dll isn't called in the pause and main menus.
+// The probe calls DLSS Enabler directly, its reads don't update the Mode Cache, its telemetry or the status page.
+static int PollUntil(DLSS_ENABLER_FRAMEGENERATION_MODE setMode, bool isHolding, ProbeClock::time_point deadline, uint64_t generation, ProbeClock::time_point& reachedAt)
+{
+    for (;;)
+    {
+        if (g_probeGeneration.load(std::memory_order_acquire) != generation || !g_isProbeRunning.load(std::memory_order_acquire))
+        {
+            return -1;
+        }
+
+        GetFrameGenerationModeFunc getFunc = g_GetFrameGenerationModeFunc;
+        if (!getFunc || GetReadyState() != ReadyState::Ready)
+        {
+            return -2;
+        }
+
+        DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+        if (getFunc(currentMode) == DLSS_ENABLER_RESULT_SUCCESS && IsModeApplied(setMode, currentMode) != isHolding)
+        {
+            reachedAt = ProbeClock::now();
+            return 1;
+        }
+
+        if (ProbeClock::now() >= deadline)
+        {
+            return 0;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(TRANSITION_PROBE_POLL_MS));
+    }
+}
+
+/////////////////////
+// Probe Thread
+/////////////////////
+
+static void TransitionProbeThread()
+{
+    for (;;)
+    {
+        PendingProbe probe;
+        uint64_t generation;
+        {
+            std::unique_lock<std::mutex> lock(g_probeMutex);
+            g_probeCondition.wait(lock, [] { return g_isProbeStopping || g_pendingProbe.isPending; });
+            if (g_isProbeStopping)
+            {
+                return;
+            }
+
+            probe = g_pendingProbe;
+            g_pendingProbe.isPending = false;
+            generation = g_probeGeneration.load(std::memory_order_acquire);
+        }
+
+        const BridgeConfig& config = GetConfig();
+        std::chrono::milliseconds timeout(config.probeTimeoutMs);
+        std::chrono::milliseconds holdTime(config.probeHoldMs);
+
+        ProbeClock::time_point visibleAt;
+        int visible = PollUntil(probe.setMode, false, probe.start + timeout, generation, visibleAt);
+        if (visible == -2)
+        {
+            continue;
+        }
+        if (visible < 0)
+        {
+            CountSuperseded();
+            continue;
+        }
+        if (visible == 0)
+        {
+            g_transitionTimedOut.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        ProbeClock::time_point revertedAt;
+        int reverted = PollUntil(probe.setMode, true, visibleAt + holdTime, generation, revertedAt);
+        if (reverted == -2)
+        {
+            continue;
+        }
+        if (reverted < 0)
+        {
+            CountSuperseded();
+            continue;
+        }
+        if (reverted > 0)
+        {
+            g_transitionReverted.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(visibleAt - probe.start).count();
+        RecordLatency(static_cast<uint32_t>(latency));
+    }
+}
+
+/////////////////////
+// Start / Stop
+/////////////////////
+
+bool StartTransitionProbe()
+{
+    if (g_probeThread.joinable())
+    {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_probeMutex);
+        g_pendingProbe = {};
+        g_isProbeStopping = false;
+    }
+
+    g_probeThread = std::thread(TransitionProbeThread);
+    g_isProbeRunning.store(true, std::memory_order_release);
+    return true;
+}
+
+void StopTransitionProbe()
+{
+    if (!g_probeThread.joinable())
+    {
+        return;
+    }
+
+    g_isProbeRunning.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(g_probeMutex);
+        g_isProbeStopping = true;
+    }
+    g_probeCondition.notify_one();
+    g_probeThread.join();
+}
+
+bool IsTransitionProbeRunning()
+{
+    return g_isProbeRunning.load(std::memory_order_acquire);
+}
+
+void ProbeTransition(DLSS_ENABLER_FRAMEGENERATION_MODE setMode)
+{
+    if (!g_isProbeRunning.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_probeMutex);
+        if (g_pendingProbe.isPending)
+        {
+            g_transitionSuperseded.fetch_add(1, std::memory_order_relaxed);
+        }
+        g_pendingProbe.isPending = true;
+        g_pendingProbe.setMode = setMode;
+        g_pendingProbe.start = ProbeClock::now();
+        g_probeGeneration.fetch_add(1, std::memory_order_acq_rel);
+    }
+    g_probeCondition.notify_one();
+}
+
+/////////////////////
+// Results
+/////////////////////
+
+void GetTransitionHistogram(uint32_t buckets[TRANSITION_HISTOGRAM_BUCKETS])
+{
+    for (uint32_t i = 0; i < TRANSITION_HISTOGRAM_BUCKETS; ++i)
+    {
+        buckets[i] = g_transitionHistogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+TransitionStats GetTransitionStats()
+{
+    TransitionStats stats = {};
+    stats.samples = g_transitionSamples.load(std::memory_order_relaxed);
+    stats.reverted = g_transitionReverted.load(std::memory_order_relaxed);
+    stats.timedOut = g_transitionTimedOut.load(std::memory_order_relaxed);
+    stats.superseded = g_transitionSuperseded.load(std::memory_order_relaxed);
+    stats.lastLatencyUs = g_lastTransitionLatencyUs.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include "DLSSEnablerApi.h"
+
+// The Transition Probe follows every successful set with a bounded read-back on a background thread,
+// measuring how long DLSS Enabler takes until GetFrameGenerationMode reflects the change.
+// Transitions that never become visible, or are reverted shortly after, are counted instead of measured.
+// Probes still running when the game pauses or returns to the main menu are dropped without being counted.
+
+constexpr uint32_t TRANSITION_HISTOGRAM_BUCKETS = 12;
+constexpr uint32_t TRANSITION_HISTOGRAM_FIRST_BOUND_US = 125; // bucket i holds latencies below 125us << i, the last one the rest
+
+// Timeout and hold time defaults, both can be changed in the Config
+constexpr uint32_t TRANSITION_PROBE_POLL_MS = 1;
+constexpr uint32_t TRANSITION_PROBE_TIMEOUT_MS = 500;
+constexpr uint32_t TRANSITION_PROBE_HOLD_MS = 50;
+
+struct TransitionStats
+{
+    uint32_t samples;       // transitions that became visible and held
+    uint32_t reverted;      // became visible, then changed back within the hold time
+    uint32_t timedOut;      // never became visible within the timeout
+    uint32_t superseded;    // another set was made before the probe finished
+    uint32_t lastLatencyUs;
+};
+
+bool StartTransitionProbe();
+void StopTransitionProbe();
+bool IsTransitionProbeRunning();
+
+// Called after a successful set, a no-op when the probe isn't running
+void ProbeTransition(DLSS_ENABLER_FRAMEGENERATION_MODE setMode);
+
+// Whether a GetFrameGenerationMode value reflects the given set mode
+bool IsModeApplied(DLSS_ENABLER_FRAMEGENERATION_MODE setMode, int32_t observedMode);
+
+void GetTransitionHistogram(uint32_t buckets[TRANSITION_HISTOGRAM_BUCKETS]);
+TransitionStats GetTransitionStats();
@@ -0,0 +1,189 @@
+#include "AllocAudit.h"
+#include "Batch.h"
+#include "BridgeClock.h"
+#include "FakeEnabler.h"
+#include "Handlers.h"
+#include "Log.h"
+#include "ModeCache.h"
+#include "NativeApi.h"
+#include "StatusPage.h"
+#include <cstdio>
+
+// Calls the getter and setter paths under the allocation audit, the way the plugin's handlers do, with the debug
+// logging off and on. Exits with 1 if any of them allocated after the warm-up calls.
+
+constexpr uint32_t AUDIT_CALLS = 64;
+
+static void ReportViolation(const char* handlerName, uint64_t allocations)
+{
+    fprintf(stderr, "%s allocated %llu time(s) after warm-up\n", handlerName, static_cast<unsigned long long>(allocations));
+}
+
+// Logged messages are formatted like in the plugin, then dropped
+void WriteLog(LogSeverity severity, const char* message)
+{
+    (void)severity;
+    (void)message;
+}
+
+static void OnModeChanged(int32_t newMode, int32_t oldMode, void* userData)
+{
+    (void)newMode;
+    (void)oldMode;
+    (void)userData;
+}
+
+/////////////////////
+// Mode Cache
+/////////////////////
+
+static void AuditQueryFrameGenerationMode(bool canUseCache)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE mode;
+    QueryFrameGenerationMode(mode, canUseCache);
+}
+
+static void AuditApplyFrameGenerationMode(uint32_t call)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    ApplyFrameGenerationMode(static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(call % 4));
+}
+
+static void AuditGetModeSnapshot()
+{
+    ALLOC_AUDIT_SCOPE();
+
+    ModeSnapshot snapshot = GetModeSnapshot();
+    (void)snapshot;
+}
+
+static void AuditRunBatch()
+{
+    ALLOC_AUDIT_SCOPE();
+
+    const int32_t ops[] = { EncodeBatchOp(BatchOp::Get), EncodeBatchOp(BatchOp::SetFG, 1), EncodeBatchOp(BatchOp::Toggle), EncodeBatchOp(BatchOp::Get) };
+    int32_t results[4];
+    RunBatch(ops, 4, results);
+}
+
+/////////////////////
+// Handlers
+/////////////////////
+
+static void AuditHandleGetFrameGenerationMode()
+{
+    ALLOC_AUDIT_SCOPE();
+
+    DLSS_ENABLER_FRAMEGENERATION_MODE mode;
+    HandleGetFrameGenerationMode(mode);
+}
+
+static void AuditHandleGetFrameGenerationState()
+{
+    ALLOC_AUDIT_SCOPE();
+
+    bool isEnabled;
+    HandleGetFrameGenerationState(isEnabled);
+}
+
+static void AuditHandleGetDynamicFrameGenerationState()
+{
+    ALLOC_AUDIT_SCOPE();
+
+    bool isEnabled;
+    HandleGetDynamicFrameGenerationState(isEnabled);
+}
+
+static void AuditHandleSetFrameGenerationMode(uint32_t call)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    HandleSetFrameGenerationMode(static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(call % 4));
+}
+
+static void AuditHandleSetFrameGenerationState(uint32_t call)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    HandleSetFrameGenerationState((call & 1) == 0);
+}
+
+static void AuditHandleSetDynamicFrameGenerationState(uint32_t call)
+{
+    ALLOC_AUDIT_SCOPE();
+
+    HandleSetDynamicFrameGenerationState((call & 1) == 0);
+}
+
+/////////////////////
+// Main
+/////////////////////
+
+int main()
+{
+    InstallAllocAudit(&ReportViolation);
+
+    SetBridgeClockSource(nullptr);
+    ResetModeCache();
+    ResetFakeEnabler(0);
+    uint16_t version[4] = { 0, 0, 0, 0 };
+    SetLoadedState(true, version);
+    SetReadyState(true);
+
+    // The status page is optional, its publishing is audited when it opens
+    bool isStatusPageOpen = OpenStatusPage();
+
+    const DEBridge_Api* api = GetNativeApi(DE_BRIDGE_API_VERSION);
+    if (!api)
+    {
+        fprintf(stderr, "The native API isn't available\n");
+        return 1;
+    }
+    uint32_t subscription = api->Subscribe(&OnModeChanged, nullptr);
+
+    // The second half of the calls logs debug messages
+    for (uint32_t call = 0; call < AUDIT_CALLS; ++call)
+    {
+        bool isDebugEnabled = call >= AUDIT_CALLS / 2;
+        g_deBridgeDebug.store(isDebugEnabled, std::memory_order_relaxed);
+        g_deBridgeDebugExt.store(isDebugEnabled, std::memory_order_relaxed);
+
+        AuditHandleGetFrameGenerationMode();
+        AuditHandleGetFrameGenerationState();
+        AuditHandleGetDynamicFrameGenerationState();
+        AuditHandleSetFrameGenerationMode(call);
+        AuditHandleSetFrameGenerationState(call);
+        AuditHandleSetDynamicFrameGenerationState(call);
+
+        AuditQueryFrameGenerationMode(true);
+        AuditQueryFrameGenerationMode(false);
+        AuditApplyFrameGenerationMode(call);
+        AuditGetModeSnapshot();
+        AuditRunBatch();
+
+        int32_t mode;
+        api->GetFrameGenerationMode(&mode);
+        api->SetFrameGenerationMode(static_cast<int32_t>(call % 4));
+
+        DEBridge_Snapshot snapshot = {};
+        snapshot.size = sizeof(snapshot);
+        api->GetSnapshot(&snapshot);
+    }
+
+    g_deBridgeDebug.store(false, std::memory_order_relaxed);
+    g_deBridgeDebugExt.store(false, std::memory_order_relaxed);
+    api->Unsubscribe(subscription);
+    if (isStatusPageOpen)
+    {
+        CloseStatusPage();
+    }
+    ResetModeCache();
+
+    uint64_t violations = GetAllocAuditViolations();
+    printf("Allocation audit: %llu violation(s) in %u calls per path, status page %s\n",
+        static_cast<unsigned long long>(violations), AUDIT_CALLS, isStatusPageOpen ? "open" : "not available");
+    return violations > 0 ? 1 : 0;
+}
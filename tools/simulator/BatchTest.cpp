@@ -0,0 +1,74 @@
+#include "Batch.h"
+#include "FakeEnabler.h"
+#include "ModeCache.h"
+#include <cstdio>
+
+// Runs batches against the Fake Enabler. Exits with 1 if any check fails.
+
+uint32_t g_failures = 0;
+
+static void Check(const char* name, int64_t actual, int64_t expected)
+{
+    if (actual != expected)
+    {
+        fprintf(stderr, "%s: %lld, expected %lld\n", name, static_cast<long long>(actual), static_cast<long long>(expected));
+        ++g_failures;
+    }
+}
+
+static void Reset()
+{
+    ResetModeCache();
+    ResetFakeEnabler(0);
+    uint16_t version[4] = { 0, 0, 0, 0 };
+    SetLoadedState(true, version);
+    SetReadyState(true);
+}
+
+/////////////////////
+// Cases
+/////////////////////
+
+static void TestValidBatch()
+{
+    Reset();
+
+    const int32_t ops[] = { EncodeBatchOp(BatchOp::SetDFG, 1), EncodeBatchOp(BatchOp::Get), EncodeBatchOp(BatchOp::SetMode, 4) };
+    int32_t results[3];
+    Check("failed operations", RunBatch(ops, 3, results), 1);
+    Check("set DFG on", results[0], BATCH_RESULT_SUCCESS);
+    Check("get after the set", results[1], 2);
+    Check("set mode 4", results[2], BATCH_RESULT_BAD_ARGUMENT);
+    Check("mode", GetFakeEnablerMode(), 2);
+}
+
+// 257 as the argument would run as mode 1 if only the argument's byte were read
+static void TestMalformedOpRunsNothing()
+{
+    Reset();
+
+    const int32_t ops[] = { EncodeBatchOp(BatchOp::SetFG, 1), EncodeBatchOp(BatchOp::SetMode, 257), -1 };
+    int32_t results[3];
+    Check("failed operations", RunBatch(ops, 3, results), 3);
+    for (int32_t result : results)
+    {
+        Check("result", result, BATCH_RESULT_BAD_ARGUMENT);
+    }
+    Check("mode", GetFakeEnablerMode(), 0);
+    Check("set calls", static_cast<int64_t>(GetModeSnapshot().setCalls), 0);
+}
+
+/////////////////////
+// Main
+/////////////////////
+
+int main()
+{
+    TestValidBatch();
+    TestMalformedOpRunsNothing();
+
+    ResetModeCache();
+
+    printf("Batch: %u failed check(s)\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+#include "BenchHandlers.h"
+#include "BridgeClock.h"
+#include "FakeEnabler.h"
+#include "Log.h"
+#include "ModeCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Handlers of both build variants, called back to back against the Fake Enabler.
+// Each case is run a few rounds and the fastest kept, the difference is the cost of the instrumentation.
+
+struct BenchOptions
+{
+    uint64_t calls = 2000000;
+    uint32_t rounds = 5;
+    bool isDebugEnabled = false;
+};
+
+struct BenchCase
+{
+    const char* name;
+    double (*run)(const BenchHandlers& handlers, uint64_t calls);
+};
+
+// Bytes the handlers logged, so writing a message isn't optimized away
+volatile uint64_t g_benchLoggedBytes = 0;
+
+void WriteLog(LogSeverity severity, const char* message)
+{
+    (void)severity;
+    g_benchLoggedBytes = g_benchLoggedBytes + strlen(message);
+}
+
+/////////////////////
+// Cases
+/////////////////////
+
+static double RunGetFrameGenerationMode(const BenchHandlers& handlers, uint64_t calls)
+{
+    int32_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < calls; ++i)
+    {
+        sum += handlers.getFrameGenerationMode();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    volatile int32_t sink = sum;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+static double RunSetFrameGenerationState(const BenchHandlers& handlers, uint64_t calls)
+{
+    uint64_t succeeded = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < calls; ++i)
+    {
+        succeeded += handlers.setFrameGenerationState((i & 1) == 0);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    volatile uint64_t sink = succeeded;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+static const BenchCase BENCH_CASES[] = {
+    { "GetFrameGenerationMode", &RunGetFrameGenerationMode },
+    { "SetFrameGenerationState", &RunSetFrameGenerationState },
+};
+
+/////////////////////
+// Main
+/////////////////////
+
+// Rounds of the two variants alternate, so frequency changes and other load hit both alike
+static void RunBestOf(const BenchCase& benchCase, const BenchHandlers* handlers[2], const BenchOptions& options, double bestNs[2])
+{
+    for (uint32_t round = 0; round < options.rounds; ++round)
+    {
+        for (uint32_t variant = 0; variant < 2; ++variant)
+        {
+            ResetLogState();
+            double nsPerCall = benchCase.run(*handlers[variant], options.calls);
+            if (round == 0 || nsPerCall < bestNs[variant])
+            {
+                bestNs[variant] = nsPerCall;
+            }
+        }
+    }
+}
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: de-bridge-bench [options]\n"
+        "  --calls <n>    Handler calls per round (default 2000000)\n"
+        "  --rounds <n>   Rounds per case, the fastest is reported (default 5)\n"
+        "  --debug        Turn the runtime debug logging on, only the instrumented variant has it\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* name = argv[i];
+        if (strcmp(name, "--debug") == 0)
+        {
+            options.isDebugEnabled = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (strcmp(name, "--calls") == 0) options.calls = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--rounds") == 0) options.rounds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else return false;
+    }
+
+    return options.calls > 0 && options.rounds > 0;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    // The default config has no cache TTL, so like in the game with the defaults, every get reaches the Fake Enabler
+    SetBridgeClockSource(nullptr);
+    ResetModeCache();
+    ResetFakeEnabler(0);
+    uint16_t version[4] = { 0, 0, 0, 0 };
+    SetLoadedState(true, version);
+    SetReadyState(true);
+
+    g_deBridgeDebug.store(options.isDebugEnabled, std::memory_order_relaxed);
+    g_deBridgeDebugExt.store(options.isDebugEnabled, std::memory_order_relaxed);
+
+    const BenchHandlers* handlers[2] = { &instrumented::BENCH_HANDLERS, &production::BENCH_HANDLERS };
+
+    printf("Handler calls: %llu per round, fastest of %u round(s), debug logging %s\n",
+        static_cast<unsigned long long>(options.calls), options.rounds, options.isDebugEnabled ? "on" : "off");
+    printf("%-26s %14s %14s %14s\n", "Handler", handlers[0]->variantName, handlers[1]->variantName, "difference");
+
+    for (const BenchCase& benchCase : BENCH_CASES)
+    {
+        double bestNs[2] = {};
+        RunBestOf(benchCase, handlers, options, bestNs);
+        printf("%-26s %11.2f ns %11.2f ns %11.2f ns\n", benchCase.name, bestNs[0], bestNs[1], bestNs[0] - bestNs[1]);
+    }
+
+    ResetModeCache();
+    return 0;
+}
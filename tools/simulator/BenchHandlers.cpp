@@ -0,0 +1,22 @@
+#include "BenchHandlers.h"
+#include "Handlers.h"
+
+#define BENCH_STRINGIFY(name) BENCH_STRINGIFY_NAME(name)
+#define BENCH_STRINGIFY_NAME(name) #name
+
+namespace DE_BRIDGE_HANDLERS_NAMESPACE
+{
+
+static int32_t GetFrameGenerationMode()
+{
+    DLSS_ENABLER_FRAMEGENERATION_MODE currentMode;
+    if (!HandleGetFrameGenerationMode(currentMode))
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+    return currentMode;
+}
+
+const BenchHandlers BENCH_HANDLERS = { BENCH_STRINGIFY(DE_BRIDGE_HANDLERS_NAMESPACE), &GetFrameGenerationMode, &HandleSetFrameGenerationState };
+
+}
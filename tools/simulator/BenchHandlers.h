@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// The plugin's handler bodies (src/Handlers.cpp), without RED4ext's stack frame and the readiness check.
+// Handlers.cpp and BenchHandlers.cpp are compiled once per build variant, each into the namespace below that
+// DE_BRIDGE_HANDLERS_NAMESPACE names.
+
+struct BenchHandlers
+{
+    const char* variantName;
+    int32_t (*getFrameGenerationMode)();
+    bool (*setFrameGenerationState)(bool shouldEnable);
+};
+
+namespace instrumented
+{
+    extern const BenchHandlers BENCH_HANDLERS;
+}
+
+namespace production
+{
+    extern const BenchHandlers BENCH_HANDLERS;
+}
@@ -0,0 +1,108 @@
+#include "FakeEnabler.h"
+#include "BridgeClock.h"
+
+// Resolved from dlss-enabler.dll in the plugin, set to the Fake Enabler by ResetFakeEnabler here
+GetFrameGenerationModeFunc g_GetFrameGenerationModeFunc = nullptr;
+SetFrameGenerationModeFunc g_SetFrameGenerationModeFunc = nullptr;
+
+int32_t g_fakeMode = 0;
+int32_t g_fakePendingMode = -1;
+int64_t g_fakePendingAtMs = 0;
+uint32_t g_fakeLatencyMs = 0;
+uint32_t g_fakeFlips = 0;
+bool g_isFakeAvailable = true;
+
+/////////////////////
+// API
+/////////////////////
+
+static DLSS_ENABLER_RESULT FakeGetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE& mode)
+{
+    if (!g_isFakeAvailable)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    mode = static_cast<DLSS_ENABLER_FRAMEGENERATION_MODE>(g_fakeMode);
+    return DLSS_ENABLER_RESULT_SUCCESS;
+}
+
+static DLSS_ENABLER_RESULT FakeSetFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_MODE mode)
+{
+    if (!g_isFakeAvailable)
+    {
+        return DLSS_ENABLER_RESULT_FAIL_UNSUPPORTED;
+    }
+
+    // Sets stack on the state still on its way, bit 0 is FG, bit 1 DFG
+    int32_t target = g_fakePendingMode >= 0 ? g_fakePendingMode : g_fakeMode;
+    switch (mode)
+    {
+    case DLSS_ENABLER_FRAMEGENERATION_DISABLED:
+        target = 0;
+        break;
+    case DLSS_ENABLER_FRAMEGENERATION_ENABLED:
+        target |= 1;
+        break;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED:
+        target &= ~2;
+        break;
+    case DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED:
+        target |= 2;
+        break;
+    default:
+        return DLSS_ENABLER_RESULT_FAIL_BAD_ARGUMENT;
+    }
+
+    g_fakePendingMode = target;
+    g_fakePendingAtMs = GetBridgeClockMs() + g_fakeLatencyMs;
+    UpdateFakeEnabler(GetBridgeClockMs());
+    return DLSS_ENABLER_RESULT_SUCCESS;
+}
+
+/////////////////////
+// Simulation
+/////////////////////
+
+void ResetFakeEnabler(uint32_t applyLatencyMs)
+{
+    g_fakeMode = 0;
+    g_fakePendingMode = -1;
+    g_fakePendingAtMs = 0;
+    g_fakeLatencyMs = applyLatencyMs;
+    g_fakeFlips = 0;
+    g_isFakeAvailable = true;
+
+    g_GetFrameGenerationModeFunc = &FakeGetFrameGenerationMode;
+    g_SetFrameGenerationModeFunc = &FakeSetFrameGenerationMode;
+}
+
+void SetFakeEnablerAvailable(bool isAvailable)
+{
+    g_isFakeAvailable = isAvailable;
+}
+
+void UpdateFakeEnabler(int64_t nowMs)
+{
+    if (g_fakePendingMode < 0 || nowMs < g_fakePendingAtMs)
+    {
+        return;
+    }
+
+    if (g_fakePendingMode != g_fakeMode)
+    {
+        g_fakeMode = g_fakePendingMode;
+        ++g_fakeFlips;
+    }
+    g_fakePendingMode = -1;
+}
+
+int32_t GetFakeEnablerMode()
+{
+    return g_fakeMode;
+}
+
+uint32_t GetFakeEnablerFlips()
+{
+    return g_fakeFlips;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include "DLSSEnablerApi.h"
+
+// The Fake Enabler stands in for dlss-enabler.dll. It follows DLSS Enabler's API: set modes flip one part of the state
+// (FG or DFG), get reports both, and both fail while the game is paused or in a menu. A set becomes visible only after
+// the configured latency on the simulator's clock.
+
+void ResetFakeEnabler(uint32_t applyLatencyMs);
+void SetFakeEnablerAvailable(bool isAvailable);
+
+// Makes sets older than the latency visible
+void UpdateFakeEnabler(int64_t nowMs);
+
+// The mode DLSS Enabler actually runs with, and how many times it changed
+int32_t GetFakeEnablerMode();
+uint32_t GetFakeEnablerFlips();
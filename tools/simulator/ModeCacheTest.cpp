@@ -0,0 +1,118 @@
+#include "BridgeClock.h"
+#include "FakeEnabler.h"
+#include "ModeCache.h"
+#include <cstdio>
+
+// Checks the mode the Mode Cache expects sets to result in, against the Fake Enabler on a synthetic clock.
+// Exits with 1 if any check fails.
+
+constexpr uint32_t SET_LATENCY_MS = 20;
+
+int64_t g_testTimeMs = 0;
+int32_t g_lastExpectedMode = MODE_UNKNOWN;
+uint32_t g_failures = 0;
+
+static int64_t GetTestClockMs()
+{
+    return g_testTimeMs;
+}
+
+static void OnModeSet(int32_t expectedMode, void* userData)
+{
+    (void)userData;
+    g_lastExpectedMode = expectedMode;
+}
+
+static void Check(const char* name, int32_t actual, int32_t expected)
+{
+    if (actual != expected)
+    {
+        fprintf(stderr, "%s: %d, expected %d\n", name, actual, expected);
+        ++g_failures;
+    }
+}
+
+static void AdvanceClock(int64_t elapsedMs)
+{
+    g_testTimeMs += elapsedMs;
+    UpdateFakeEnabler(g_testTimeMs);
+}
+
+static int32_t ReadBack()
+{
+    DLSS_ENABLER_FRAMEGENERATION_MODE mode;
+    return QueryFrameGenerationMode(mode, false) == DLSS_ENABLER_RESULT_SUCCESS ? mode : MODE_UNKNOWN;
+}
+
+static void Reset(uint32_t setLatencyMs)
+{
+    g_testTimeMs = 0;
+    ResetModeCache();
+    ResetFakeEnabler(setLatencyMs);
+    uint16_t version[4] = { 0, 0, 0, 0 };
+    SetLoadedState(true, version);
+    SetReadyState(true);
+    g_lastExpectedMode = MODE_UNKNOWN;
+}
+
+/////////////////////
+// Cases
+/////////////////////
+
+// A read-back taken before the first set is visible doesn't reset what the second one stacks on
+static void TestStaleReadBetweenSets()
+{
+    Reset(SET_LATENCY_MS);
+    Check("initial read-back", ReadBack(), 0);
+
+    ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_ENABLED);
+    Check("expected after FG on", g_lastExpectedMode, 1);
+
+    AdvanceClock(5);
+    Check("stale read-back", ReadBack(), 0);
+
+    ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED);
+    Check("expected after DFG on", g_lastExpectedMode, 3);
+
+    AdvanceClock(SET_LATENCY_MS);
+    Check("read-back once visible", ReadBack(), 3);
+
+    ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_DFG_DISABLED);
+    Check("expected after DFG off", g_lastExpectedMode, 1);
+}
+
+// A set that's never read back stops being predicted after the timeout
+static void TestLostSet()
+{
+    Reset(SET_READ_BACK_TIMEOUT_MS * 4);
+    Check("initial read-back", ReadBack(), 0);
+
+    ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_ENABLED);
+    Check("expected after FG on", g_lastExpectedMode, 1);
+
+    AdvanceClock(SET_READ_BACK_TIMEOUT_MS);
+    Check("read-back after the timeout", ReadBack(), 0);
+
+    ApplyFrameGenerationMode(DLSS_ENABLER_FRAMEGENERATION_DFG_ENABLED);
+    Check("expected after DFG on", g_lastExpectedMode, 2);
+}
+
+/////////////////////
+// Main
+/////////////////////
+
+int main()
+{
+    SetBridgeClockSource(&GetTestClockMs);
+    SetModeSetCallback(&OnModeSet, nullptr);
+
+    TestStaleReadBetweenSets();
+    TestLostSet();
+
+    SetModeSetCallback(nullptr, nullptr);
+    SetBridgeClockSource(nullptr);
+    ResetModeCache();
+
+    printf("Mode Cache: %u failed check(s)\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
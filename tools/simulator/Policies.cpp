@@ -0,0 +1,69 @@
+#include "Policies.h"
+
+const char* g_policyNames[] = { "fixed", "threshold", "hysteresis", "dynamic" };
+
+bool ParsePolicyKind(std::string_view name, PolicyKind& kind)
+{
+    for (uint8_t i = 0; i < sizeof(g_policyNames) / sizeof(g_policyNames[0]); ++i)
+    {
+        if (name == g_policyNames[i])
+        {
+            kind = static_cast<PolicyKind>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char* GetPolicyName(PolicyKind kind)
+{
+    return g_policyNames[static_cast<uint8_t>(kind)];
+}
+
+void ResetPolicy(PolicyState& state)
+{
+    state.smoothedMs = 0.0;
+    state.lastDecision = -1;
+    state.framesSinceChange = 0;
+}
+
+int32_t DecidePolicyMode(PolicyKind kind, const PolicyOptions& options, PolicyState& state, double frameTimeMs)
+{
+    state.smoothedMs = state.smoothedMs == 0.0 ? frameTimeMs : state.smoothedMs + options.smoothing * (frameTimeMs - state.smoothedMs);
+    ++state.framesSinceChange;
+
+    int32_t decision = state.lastDecision;
+    switch (kind)
+    {
+    case PolicyKind::Fixed:
+        return -1;
+    case PolicyKind::Threshold:
+        decision = frameTimeMs > options.enableAboveMs ? 1 : 0;
+        break;
+    case PolicyKind::Hysteresis:
+        if (state.lastDecision >= 0 && state.framesSinceChange < options.holdFrames)
+        {
+            return state.lastDecision;
+        }
+        if (state.smoothedMs > options.enableAboveMs)
+        {
+            decision = 1;
+        }
+        else if (state.smoothedMs < options.disableBelowMs || state.lastDecision < 0)
+        {
+            decision = 0;
+        }
+        break;
+    case PolicyKind::Dynamic:
+        decision = 3;
+        break;
+    }
+
+    if (decision != state.lastDecision)
+    {
+        state.lastDecision = decision;
+        state.framesSinceChange = 0;
+    }
+    return decision;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Policies decide the Frame Generation mode from the rendered frame times, once per simulated frame.
+// They answer with a GetFrameGenerationMode value (0 off, 1 FG, 3 FG and DFG), or -1 to leave the mode as it is.
+
+enum class PolicyKind : uint8_t
+{
+    Fixed = 0,       // never changes the mode, e.g. to measure the default preset
+    Threshold = 1,   // FG on above a single frame time threshold, no smoothing
+    Hysteresis = 2,  // FG on above, off below two thresholds of the smoothed frame time, with a minimum hold
+    Dynamic = 3,     // FG and DFG on, leaving the decision per frame to DFG
+};
+
+struct PolicyOptions
+{
+    double enableAboveMs = 16.7;
+    double disableBelowMs = 12.5;
+    double smoothing = 0.1;      // weight of the newest frame in the smoothed frame time
+    uint32_t holdFrames = 120;   // frames to keep a mode before changing it again
+};
+
+struct PolicyState
+{
+    double smoothedMs;
+    int32_t lastDecision;
+    uint32_t framesSinceChange;
+};
+
+bool ParsePolicyKind(std::string_view name, PolicyKind& kind);
+const char* GetPolicyName(PolicyKind kind);
+
+void ResetPolicy(PolicyState& state);
+int32_t DecidePolicyMode(PolicyKind kind, const PolicyOptions& options, PolicyState& state, double frameTimeMs);
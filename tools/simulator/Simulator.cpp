@@ -0,0 +1,473 @@
+#include "BridgeClock.h"
+#include "CommandQueue.h"
+#include "Config.h"
+#include "FakeEnabler.h"
+#include "Log.h"
+#include "ModeCache.h"
+#include "Policies.h"
+#include "ProfileStore.h"
+#include "SafePoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The simulator runs the bridge's Mode Cache, Command Queue and set paths headless, frame by frame on a synthetic clock.
+// Frame times come from a trace file, pause and menu events from an optional script. Each frame ends with the plugin's
+// own safe point (RunSafePoint), readiness comes from the events instead of RTTI. See docs/simulator.md.
+
+enum class SimEventKind : uint8_t
+{
+    Pause = 0,
+    Resume = 1,
+    Menu = 2,
+    Load = 3,
+};
+
+struct SimEvent
+{
+    uint64_t frame;
+    SimEventKind kind;
+};
+
+struct SimOptions
+{
+    const char* tracePath = nullptr;
+    const char* eventsPath = nullptr;
+    const char* configPath = nullptr;
+    PolicyKind policy = PolicyKind::Hysteresis;
+    PolicyOptions policyOptions;
+    uint64_t frames = 0;            // 0: the trace's length
+    uint32_t latencyMs = 20;        // until a set is visible in GetFrameGenerationMode
+    double fgCost = 0.1;            // extra render cost of Frame Generation
+    double dfgThresholdMs = 8.3;    // DFG generates frames only when rendering is slower than this
+    uint32_t maxFlips = UINT32_MAX;
+};
+
+struct SimState
+{
+    bool isPaused;
+    bool isInMenu;
+    int32_t lastRequestedMode;
+    PolicyState policy;
+};
+
+struct SimReport
+{
+    double timeInModeMs[4];
+    double notReadyMs;
+    uint32_t queueFullDrops;
+    std::vector<float> renderedMs;
+    std::vector<float> estimatedMs;
+};
+
+int64_t g_simTimeUs = 0;
+GameReadiness g_simReadiness = GameReadiness::MainMenu;
+
+static int64_t GetSimClockMs()
+{
+    return g_simTimeUs / 1000;
+}
+
+static GameReadiness CheckSimReadiness()
+{
+    return g_simReadiness;
+}
+
+// Errors only, the report is the simulator's output
+void WriteLog(LogSeverity severity, const char* message)
+{
+    if (severity == LogSeverity::Error)
+    {
+        fprintf(stderr, "%s\n", message);
+    }
+}
+
+/////////////////////
+// Input
+/////////////////////
+
+static std::string_view TrimLine(std::string_view line)
+{
+    size_t comment = line.find('#');
+    line = line.substr(0, comment);
+    while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+    {
+        line.remove_prefix(1);
+    }
+    while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r'))
+    {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+// One rendered frame time in milliseconds per line
+static bool LoadTrace(const char* path, std::vector<float>& trace)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open the trace: %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        std::string_view value = TrimLine(line);
+        if (value.empty())
+        {
+            continue;
+        }
+
+        std::string text(value);
+        char* end = nullptr;
+        double frameTimeMs = strtod(text.c_str(), &end);
+        if (end != text.c_str() + text.size() || frameTimeMs <= 0.0)
+        {
+            fprintf(stderr, "%s:%u: invalid frame time\n", path, lineNumber);
+            return false;
+        }
+        trace.push_back(static_cast<float>(frameTimeMs));
+    }
+
+    if (trace.empty())
+    {
+        fprintf(stderr, "The trace has no frames: %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+// "<frame> <pause|resume|menu|load>" per line, in frame order
+static bool LoadEvents(const char* path, std::vector<SimEvent>& events)
+{
+    static const char* names[] = { "pause", "resume", "menu", "load" };
+
+    std::ifstream file(path);
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open the events: %s\n", path);
+        return false;
+    }
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        std::string_view text = TrimLine(line);
+        if (text.empty())
+        {
+            continue;
+        }
+
+        size_t separator = text.find(' ');
+        std::string frameText(text.substr(0, separator));
+        std::string_view name = separator == std::string_view::npos ? std::string_view() : TrimLine(text.substr(separator + 1));
+
+        char* end = nullptr;
+        uint64_t frame = strtoull(frameText.c_str(), &end, 10);
+        bool isValid = !frameText.empty() && end == frameText.c_str() + frameText.size() && (events.empty() || frame >= events.back().frame);
+
+        SimEvent event = { frame, SimEventKind::Pause };
+        bool isKnown = false;
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            if (name == names[i])
+            {
+                event.kind = static_cast<SimEventKind>(i);
+                isKnown = true;
+            }
+        }
+
+        if (!isValid || !isKnown)
+        {
+            fprintf(stderr, "%s:%u: invalid event\n", path, lineNumber);
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    return true;
+}
+
+/////////////////////
+// Frame
+/////////////////////
+
+static double EstimateFrameTime(int32_t mode, double renderedMs, const SimOptions& options)
+{
+    bool isGenerating = (mode & 1) && (!(mode & 2) || renderedMs > options.dfgThresholdMs);
+    return isGenerating ? renderedMs * (1.0 + options.fgCost) / 2.0 : renderedMs;
+}
+
+static void ApplyEvent(const SimEvent& event, SimState& state)
+{
+    switch (event.kind)
+    {
+    case SimEventKind::Pause:
+        state.isPaused = true;
+        break;
+    case SimEventKind::Resume:
+        state.isPaused = false;
+        break;
+    case SimEventKind::Menu:
+        state.isInMenu = true;
+        break;
+    case SimEventKind::Load:
+        state.isInMenu = false;
+        state.isPaused = false;
+        break;
+    }
+}
+
+static void SimulateFrame(double renderedMs, const SimOptions& options, SimState& state, SimReport& report)
+{
+    // DLSS Enabler refuses calls in the pause and main menus as well
+    g_simReadiness = state.isInMenu ? GameReadiness::MainMenu : state.isPaused ? GameReadiness::Paused : GameReadiness::Ready;
+    bool isReady = g_simReadiness == GameReadiness::Ready;
+    SetFakeEnablerAvailable(isReady);
+
+    // The policy stands in for a script asking for a mode once the session has started, through a getter that
+    // checks readiness first. Only the parts that differ are queued.
+    ReportGameReadiness(g_simReadiness);
+    if (isReady && IsSessionStarted())
+    {
+        int32_t desiredMode = DecidePolicyMode(options.policy, options.policyOptions, state.policy, renderedMs);
+        if (desiredMode >= 0 && desiredMode != state.lastRequestedMode)
+        {
+            DLSS_ENABLER_FRAMEGENERATION_MODE observedMode;
+            if (QueryFrameGenerationMode(observedMode) == DLSS_ENABLER_RESULT_SUCCESS)
+            {
+                DLSS_ENABLER_FRAMEGENERATION_MODE setModes[MAX_PRESET_MODES];
+                uint32_t setCount = GetProfileSetModes(observedMode, desiredMode, setModes);
+                for (uint32_t i = 0; i < setCount; ++i)
+                {
+                    if (!QueueFrameGenerationMode(setModes[i]))
+                    {
+                        ++report.queueFullDrops;
+                    }
+                }
+                state.lastRequestedMode = desiredMode;
+            }
+        }
+    }
+
+    // OnRunningUpdate: starts the session with the default preset and applies what's queued
+    RunSafePoint(&CheckSimReadiness);
+
+    UpdateFakeEnabler(GetSimClockMs());
+
+    int32_t mode = isReady ? GetFakeEnablerMode() : 0;
+    if (isReady)
+    {
+        report.timeInModeMs[mode] += renderedMs;
+    }
+    else
+    {
+        report.notReadyMs += renderedMs;
+    }
+    report.renderedMs.push_back(static_cast<float>(renderedMs));
+    report.estimatedMs.push_back(static_cast<float>(EstimateFrameTime(mode, renderedMs, options)));
+
+    g_simTimeUs += static_cast<int64_t>(renderedMs * 1000.0);
+}
+
+/////////////////////
+// Report
+/////////////////////
+
+static double GetPercentile(std::vector<float>& values, double percentile)
+{
+    size_t index = static_cast<size_t>(percentile * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static double GetAverage(const std::vector<float>& values)
+{
+    double sum = 0.0;
+    for (float value : values)
+    {
+        sum += value;
+    }
+    return sum / values.size();
+}
+
+static void PrintReport(const SimOptions& options, SimReport& report, uint64_t frames, double realSeconds)
+{
+    static const char* modeNames[] = { "FG off, DFG off", "FG on,  DFG off", "FG off, DFG on ", "FG on,  DFG on " };
+
+    double simulatedMs = report.notReadyMs;
+    for (double modeMs : report.timeInModeMs)
+    {
+        simulatedMs += modeMs;
+    }
+
+    ModeSnapshot snapshot = GetModeSnapshot();
+    uint32_t flips = GetFakeEnablerFlips();
+
+    printf("Policy: %s\n", GetPolicyName(options.policy));
+    printf("Frames: %llu (%.1f s simulated, %.3f s real, %.0f frames/s)\n",
+        static_cast<unsigned long long>(frames), simulatedMs / 1000.0, realSeconds, realSeconds > 0.0 ? frames / realSeconds : 0.0);
+    printf("Mode flips: %u (%.2f per minute)\n", flips, simulatedMs > 0.0 ? flips * 60000.0 / simulatedMs : 0.0);
+    printf("Set calls: %llu, failed: %llu. Get calls: %llu, failed: %llu. Dropped by a full queue: %u\n",
+        static_cast<unsigned long long>(snapshot.setCalls), static_cast<unsigned long long>(snapshot.setFailures),
+        static_cast<unsigned long long>(snapshot.getCalls), static_cast<unsigned long long>(snapshot.getFailures), report.queueFullDrops);
+
+    printf("Time in mode:\n");
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        printf("  %d %s  %10.1f s  %5.1f%%\n", i, modeNames[i], report.timeInModeMs[i] / 1000.0, 100.0 * report.timeInModeMs[i] / simulatedMs);
+    }
+    printf("  - paused or menu    %10.1f s  %5.1f%%\n", report.notReadyMs / 1000.0, 100.0 * report.notReadyMs / simulatedMs);
+
+    // Averages first, the percentiles reorder the samples
+    double renderedAverage = GetAverage(report.renderedMs);
+    double estimatedAverage = GetAverage(report.estimatedMs);
+    double renderedP95 = GetPercentile(report.renderedMs, 0.95);
+    double estimatedP95 = GetPercentile(report.estimatedMs, 0.95);
+    double renderedP99 = GetPercentile(report.renderedMs, 0.99);
+    double estimatedP99 = GetPercentile(report.estimatedMs, 0.99);
+
+    printf("Frame time (ms)  rendered  estimated\n");
+    printf("  average        %8.2f  %9.2f\n", renderedAverage, estimatedAverage);
+    printf("  p95            %8.2f  %9.2f\n", renderedP95, estimatedP95);
+    printf("  p99            %8.2f  %9.2f\n", renderedP99, estimatedP99);
+}
+
+/////////////////////
+// Main
+/////////////////////
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: de-bridge-simulator --trace <file> [options]\n"
+        "  --events <file>            pause/menu events, \"<frame> <pause|resume|menu|load>\" per line\n"
+        "  --config <file>            dlss-enabler-bridge-2077.ini to simulate with\n"
+        "  --policy <name>            fixed, threshold, hysteresis (default) or dynamic\n"
+        "  --frames <n>               frames to simulate, the trace is looped (default: the trace's length)\n"
+        "  --latency-ms <n>           until a set is visible (default: 20)\n"
+        "  --enable-above-ms <x>      policy threshold turning FG on (default: 16.7)\n"
+        "  --disable-below-ms <x>     hysteresis threshold turning FG off (default: 12.5)\n"
+        "  --hold-frames <n>          hysteresis minimum frames between changes (default: 120)\n"
+        "  --fg-cost <x>              extra render cost of Frame Generation (default: 0.1)\n"
+        "  --dfg-threshold-ms <x>     DFG generates frames only above this frame time (default: 8.3)\n"
+        "  --max-flips <n>            exit with 1 if the mode flips more often\n");
+}
+
+static bool ParseOptions(int argc, char** argv, SimOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view name = argv[i];
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (name == "--trace") options.tracePath = value;
+        else if (name == "--events") options.eventsPath = value;
+        else if (name == "--config") options.configPath = value;
+        else if (name == "--policy") { if (!ParsePolicyKind(value, options.policy)) return false; }
+        else if (name == "--frames") options.frames = strtoull(value, nullptr, 10);
+        else if (name == "--latency-ms") options.latencyMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (name == "--enable-above-ms") options.policyOptions.enableAboveMs = strtod(value, nullptr);
+        else if (name == "--disable-below-ms") options.policyOptions.disableBelowMs = strtod(value, nullptr);
+        else if (name == "--hold-frames") options.policyOptions.holdFrames = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (name == "--fg-cost") options.fgCost = strtod(value, nullptr);
+        else if (name == "--dfg-threshold-ms") options.dfgThresholdMs = strtod(value, nullptr);
+        else if (name == "--max-flips") options.maxFlips = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else return false;
+    }
+
+    return options.tracePath != nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    SimOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<float> trace;
+    std::vector<SimEvent> events;
+    if (!LoadTrace(options.tracePath, trace) || (options.eventsPath && !LoadEvents(options.eventsPath, events)))
+    {
+        return 2;
+    }
+
+    if (options.configPath)
+    {
+        uint32_t errorCount;
+        uint32_t firstErrorLine;
+        if (!LoadConfigFile(options.configPath, errorCount, firstErrorLine))
+        {
+            fprintf(stderr, "Failed to open the config: %s\n", options.configPath);
+            return 2;
+        }
+        if (errorCount > 0)
+        {
+            fprintf(stderr, "%s:%u: %u invalid line(s), defaults are used for them\n", options.configPath, firstErrorLine, errorCount);
+        }
+    }
+
+    uint64_t frames = options.frames > 0 ? options.frames : trace.size();
+
+    g_simTimeUs = 0;
+    SetBridgeClockSource(&GetSimClockMs);
+    ResetModeCache();
+    ResetFakeEnabler(options.latencyMs);
+    uint16_t version[4] = { 0, 0, 0, 0 };
+    SetLoadedState(true, version);
+    ResetSafePoint();
+
+    SimState state = {};
+    state.lastRequestedMode = -1;
+    ResetPolicy(state.policy);
+
+    SimReport report = {};
+    report.renderedMs.reserve(frames);
+    report.estimatedMs.reserve(frames);
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t nextEvent = 0;
+    for (uint64_t frame = 0; frame < frames; ++frame)
+    {
+        while (nextEvent < events.size() && events[nextEvent].frame <= frame)
+        {
+            ApplyEvent(events[nextEvent++], state);
+        }
+
+        SimulateFrame(trace[frame % trace.size()], options, state, report);
+    }
+
+    double realSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    PrintReport(options, report, frames, realSeconds);
+
+    SetBridgeClockSource(nullptr);
+    ClearCommandQueue();
+    ResetConfig();
+
+    if (GetFakeEnablerFlips() > options.maxFlips)
+    {
+        fprintf(stderr, "Mode flipped %u times, more than the allowed %u\n", GetFakeEnablerFlips(), options.maxFlips);
+        return 1;
+    }
+    return 0;
+}